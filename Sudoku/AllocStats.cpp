@@ -0,0 +1,255 @@
+#include "AllocStats.h"
+#include "DatasetLoader.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+/* ============================================================
+   COUNTING ALLOCATOR
+   ============================================================ */
+#if SUDOKU_COUNT_ALLOCS
+namespace {
+
+std::atomic<uint64_t> globalAllocations{ 0 };
+std::atomic<uint64_t> globalBytes{ 0 };
+thread_local uint64_t threadAllocations = 0;
+thread_local uint64_t threadBytes = 0;
+
+inline void countAllocation(size_t n)
+{
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    globalBytes.fetch_add(n, std::memory_order_relaxed);
+    ++threadAllocations;
+    threadBytes += n;
+}
+
+inline void* rawAllocate(size_t n) noexcept
+{
+    countAllocation(n);
+    return std::malloc(n ? n : 1);
+}
+
+inline void* rawAllocateAligned(size_t n, std::align_val_t alignment) noexcept
+{
+    countAllocation(n);
+    size_t a = (size_t)alignment;
+#ifdef _MSC_VER
+    return _aligned_malloc(n ? n : 1, a);
+#else
+    return std::aligned_alloc(a, (std::max<size_t>(n, 1) + a - 1) / a * a);
+#endif
+}
+
+inline void rawFreeAligned(void* p) noexcept
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+inline void* checked(void* p)
+{
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+}
+
+void* operator new(size_t n) { return checked(rawAllocate(n)); }
+void* operator new[](size_t n) { return checked(rawAllocate(n)); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept { return rawAllocate(n); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return rawAllocate(n); }
+void* operator new(size_t n, std::align_val_t a) { return checked(rawAllocateAligned(n, a)); }
+void* operator new[](size_t n, std::align_val_t a) { return checked(rawAllocateAligned(n, a)); }
+void* operator new(size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return rawAllocateAligned(n, a); }
+void* operator new[](size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return rawAllocateAligned(n, a); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { rawFreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { rawFreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { rawFreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { rawFreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { rawFreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { rawFreeAligned(p); }
+
+AllocCount AllocStats::global()
+{
+    return { globalAllocations.load(std::memory_order_relaxed), globalBytes.load(std::memory_order_relaxed) };
+}
+
+AllocCount AllocStats::thread()
+{
+    return { threadAllocations, threadBytes };
+}
+#else
+AllocCount AllocStats::global() { return {}; }
+AllocCount AllocStats::thread() { return {}; }
+#endif
+
+void AllocPhase::print(std::ostream& os) const
+{
+    AllocCount d = delta();
+    os << "[ALLOC] " << std::left << std::setw(8) << name << std::right
+        << std::setw(10) << d.allocations << " allocations "
+        << std::setw(12) << d.bytes << " bytes\n";
+}
+
+/* ============================================================
+   CHECK
+   ============================================================ */
+int AllocCheck::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        std::cout << "Usage: Sudoku alloc-check [options]\n"
+            << "  --solvers a,b       engines (default: every registered engine except\n"
+            << "                      plain backtracking, plus cached-mrv and\n"
+            << "                      cached-logical-simd)\n"
+            << "  --datasets 0,1,5    dataset indices (default: all)\n"
+            << "  --dataset-root DIR  (default: Dataset)\n"
+            << "  --max N             puzzles per dataset (default: 200)\n"
+            << "Every engine warms up on the even-indexed puzzles (thread-local\n"
+            << "state, lazily built tables), then solves the odd-indexed ones; any\n"
+            << "allocation there fails the check (exit code 1). Exemption: cached-*\n"
+            << "and stored-* insert one entry per new puzzle, so for them the odd\n"
+            << "half is solved again and only that all-hits pass must not allocate.\n"
+            << "Plain backtracking needs seconds per Dataset5 puzzle and stored-*\n"
+            << "engines write solutions.store; name them in --solvers to check them.\n"
+            << "Needs a build with SUDOKU_COUNT_ALLOCS=1.\n";
+        return 0;
+    }
+
+    if (!AllocStats::counting())
+    {
+        std::cerr << "[ALLOC] allocation counting is compiled out; rebuild with SUDOKU_COUNT_ALLOCS=1\n";
+        return 2;
+    }
+
+    std::vector<std::string> solvers = cmd.getList("solvers");
+    if (solvers.empty())
+    {
+        for (const std::string& name : SolverRegistry::names())
+            if (name != "backtracking")
+                solvers.push_back(name);
+        solvers.push_back("cached-mrv");
+        solvers.push_back("cached-logical-simd");
+    }
+    std::vector<long long> ids = cmd.getIntList("datasets");
+    if (ids.empty())
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            ids.push_back(d);
+    std::string root = cmd.get("dataset-root", "Dataset");
+    size_t maxPer = (size_t)std::max(1LL, cmd.getInt("max", 200));
+
+    std::vector<Sudoku> puzzles;
+    {
+        AllocPhase load("load");
+        for (long long d : ids)
+        {
+            std::vector<Sudoku> ds = DatasetLoader::loadSingleDataset(
+                DatasetLoader::datasetFolder(root, (int)d), maxPer);
+            puzzles.insert(puzzles.end(), ds.begin(), ds.end());
+        }
+        load.print(std::cout);
+    }
+    if (puzzles.size() < 2)
+    {
+        std::cerr << "Need at least two puzzles (warm-up and check)\n";
+        return 2;
+    }
+
+    // warm-up and check on disjoint halves: the check must see puzzles the
+    // engine has not solved (no cache hits, no tables sized for them yet)
+    std::vector<Sudoku> warm, check;
+    for (size_t i = 0; i < puzzles.size(); ++i)
+        (i % 2 ? check : warm).push_back(puzzles[i]);
+
+    // solved grids of the first engine, compared against the others
+    std::vector<Sudoku> reference;
+    std::vector<Sudoku> work;
+    int failures = 0;
+
+    for (const std::string& name : solvers)
+    {
+        std::unique_ptr<ISudokuSolver> solver = SolverRegistry::create(name);
+        if (!solver)
+        {
+            std::cerr << "Unknown solver: " << name << "\n";
+            return 2;
+        }
+
+        std::cout << "\n=== " << name << " ===\n";
+        {
+            // the buffer keeps its capacity: only the first engine's copy allocates
+            AllocPhase copy("copy");
+            work = warm;
+            copy.print(std::cout);
+        }
+        {
+            AllocPhase solve("solve");
+            for (Sudoku& s : work)
+                solver->solve(s);
+            solve.print(std::cout);
+        }
+        size_t differing = 0;
+        {
+            AllocPhase compare("compare");
+            if (reference.empty())
+                reference = work;
+            else
+                for (size_t i = 0; i < work.size(); ++i)
+                    differing += reference[i] != work[i];
+            compare.print(std::cout);
+        }
+        if (differing)
+            std::cout << "[ALLOC] note: " << differing << " grids differ from " << solvers.front() << "\n";
+
+        // steady state: the other half, counted on this thread only
+        work = check;
+        AllocCount before = AllocStats::thread();
+        for (Sudoku& s : work)
+            solver->solve(s);
+        AllocCount steady = AllocStats::thread() - before;
+
+        // exemption: a cache inserts one node per new puzzle, so only its
+        // hit path (the same half again) has to be allocation-free
+        bool cache = name.rfind("cached-", 0) == 0 || name.rfind("stored-", 0) == 0;
+        bool ok = cache || steady.allocations == 0;
+        std::cout << "[ALLOC] steady  " << std::setw(10) << steady.allocations << " allocations "
+            << std::setw(12) << steady.bytes << " bytes  ("
+            << (double)steady.allocations / (double)work.size() << " per puzzle)  "
+            << (cache ? "EXEMPT (cache inserts)" : ok ? "PASS" : "FAIL") << std::endl;
+        if (cache)
+        {
+            work = check;
+            before = AllocStats::thread();
+            for (Sudoku& s : work)
+                solver->solve(s);
+            AllocCount hits = AllocStats::thread() - before;
+            ok = hits.allocations == 0;
+            std::cout << "[ALLOC] hits    " << std::setw(10) << hits.allocations << " allocations "
+                << std::setw(12) << hits.bytes << " bytes  "
+                << (ok ? "PASS" : "FAIL") << std::endl;
+        }
+        failures += !ok;
+    }
+
+    std::cout << "\n[ALLOC] " << (failures ? "FAIL: " : "PASS: ") << failures
+        << " of " << solvers.size() << " engines allocate on the solve path\n";
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include "CommandLine.h"
+
+// Heap allocation accounting, an instrumentation build: with
+// SUDOKU_COUNT_ALLOCS=1 AllocStats.cpp replaces the global operator
+// new / delete of the executable and counts every allocation, globally
+// (relaxed atomics) and per thread. Off by default, since every allocation
+// then pays two shared atomic RMWs; without it the counters stay 0 and
+// alloc-check reports that counting is compiled out. The shared library
+// does not link this file and keeps the default allocator.
+#ifndef SUDOKU_COUNT_ALLOCS
+#define SUDOKU_COUNT_ALLOCS 0
+#endif
+
+struct AllocCount
+{
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+
+    AllocCount operator-(const AllocCount& o) const { return { allocations - o.allocations, bytes - o.bytes }; }
+};
+
+class AllocStats
+{
+public:
+    static AllocCount global();   // all threads since start
+    static AllocCount thread();   // calling thread since it started
+    static constexpr bool counting() { return SUDOKU_COUNT_ALLOCS != 0; }
+};
+
+// Allocations made by all threads between construction and delta().
+class AllocPhase
+{
+public:
+    explicit AllocPhase(const char* name) : name(name), start(AllocStats::global()) {}
+
+    AllocCount delta() const { return AllocStats::global() - start; }
+    void print(std::ostream& os) const;
+
+private:
+    const char* name;
+    AllocCount start;
+};
+
+// "alloc-check" command: per-phase allocation report (load, copy, solve,
+// compare) and the zero-allocation check of every engine's solve. An engine
+// fails when it allocates on puzzles after warm-up.
+class AllocCheck
+{
+public:
+    static int runCommand(const CommandLine& cmd);
+};
@@ -0,0 +1,226 @@
+#include "AsyncSolver.h"
+#include "BacktrackingSolverMRV.h"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+/* ============================================================
+   HANDLE
+   ============================================================ */
+bool SolveHandle::cancel()
+{
+    if (!MicroBatcher::cancel(state))
+        return false;
+    if (onCancel)
+        onCancel();
+    return true;
+}
+
+bool SolveHandle::ready() const
+{
+    return future.valid() &&
+        future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+AsyncResult SolveHandle::get()
+{
+    return future.get();
+}
+
+/* ============================================================
+   SOLVER
+   ============================================================ */
+AsyncSolver::AsyncSolver(const MicroBatcher::SolverFactory& factory, const AsyncOptions& opts)
+    : options(opts), batcher(factory, opts.batch)
+{
+    if (!options.maxPending)
+        options.maxPending = 1;
+}
+
+AsyncSolver::~AsyncSolver()
+{
+    drain();
+    batcher.shutdown();
+}
+
+void AsyncSolver::release(bool callbackFollows)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        --inFlight;
+        callbacks += callbackFollows;
+    }
+    space.notify_all();
+}
+
+void AsyncSolver::runCallback(const Callback& done, AsyncResult& result)
+{
+    // drain() waits for this count, also when done throws
+    struct Finish
+    {
+        AsyncSolver* self;
+        ~Finish()
+        {
+            {
+                std::lock_guard<std::mutex> guard(self->lock);
+                --self->callbacks;
+            }
+            self->space.notify_all();
+        }
+    } finish{ this };
+
+    // the exception would end a worker thread (std::terminate) or escape
+    // from cancel(); it is counted instead
+    try {
+        done(result);
+    }
+    catch (...) {
+        failed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+SolveHandle AsyncSolver::enqueue(const Sudoku& sudoku, size_t index, Callback done)
+{
+    // completion is shared by the worker path and the cancel path; the
+    // ticket state machine guarantees only one of them runs. The future and
+    // the in-flight slot are settled before the user callback, so a callback
+    // that submits does not count against maxPending itself.
+    struct Completion
+    {
+        std::promise<AsyncResult> promise;
+        Callback done;
+        Sudoku input;
+        size_t index;
+    };
+    auto completion = std::make_shared<Completion>();
+    completion->done = std::move(done);
+    completion->input = sudoku;
+    completion->index = index;
+
+    SolveHandle handle;
+    handle.future = completion->promise.get_future().share();
+    handle.state = MicroBatcher::makeTicket();
+    handle.onCancel = [this, completion]() {
+        AsyncResult r;
+        r.sudoku = completion->input;
+        r.cancelled = true;
+        r.index = completion->index;
+        completion->promise.set_value(r);
+        release(completion->done != nullptr);
+        if (completion->done)
+            runCallback(completion->done, r);
+    };
+
+    batcher.submit(sudoku, [this, completion](Sudoku& solved, SolveResult result) {
+        AsyncResult r;
+        r.sudoku = solved;
+        r.result = result;
+        r.index = completion->index;
+        completion->promise.set_value(r);
+        release(completion->done != nullptr);
+        if (completion->done)
+            runCallback(completion->done, r);
+    }, handle.state);
+    return handle;
+}
+
+SolveHandle AsyncSolver::submit(const Sudoku& sudoku, Callback done)
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        space.wait(guard, [&] { return inFlight < options.maxPending; });
+        ++inFlight;
+    }
+    return enqueue(sudoku, 0, std::move(done));
+}
+
+std::optional<SolveHandle> AsyncSolver::trySubmit(const Sudoku& sudoku, Callback done)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (inFlight >= options.maxPending)
+            return std::nullopt;
+        ++inFlight;
+    }
+    return enqueue(sudoku, 0, std::move(done));
+}
+
+std::vector<SolveHandle> AsyncSolver::submitAll(std::span<const Sudoku> sudokus, Callback done)
+{
+    std::vector<SolveHandle> handles;
+    handles.reserve(sudokus.size());
+    for (size_t i = 0; i < sudokus.size(); ++i)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            space.wait(guard, [&] { return inFlight < options.maxPending; });
+            ++inFlight;
+        }
+        handles.push_back(enqueue(sudokus[i], i, done));
+    }
+    return handles;
+}
+
+void AsyncSolver::drain()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    space.wait(guard, [&] { return inFlight == 0 && callbacks == 0; });
+}
+
+size_t AsyncSolver::pending() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return inFlight;
+}
+
+/* ============================================================
+   CHECK
+   ============================================================ */
+size_t AsyncSolver::callbackCheck(std::ostream& log)
+{
+    const size_t COUNT = 64;
+    AsyncOptions options;
+    options.batch.workers = 2;
+    options.batch.maxBatch = 8;
+    options.maxPending = 16;
+    auto async = std::make_unique<AsyncSolver>(
+        [] { return std::make_unique<BacktrackingSolverMRV>(); }, options);
+
+    // every other callback throws
+    std::vector<Sudoku> puzzles(COUNT);   // empty grids: any solution will do
+    std::atomic<size_t> calls{ 0 };
+    std::vector<SolveHandle> handles = async->submitAll(puzzles, [&](AsyncResult& r) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        if (r.index % 2 == 0)
+            throw std::runtime_error("callback failure");
+    });
+
+    // drain() on a helper thread, so a hang is reported instead of hanging
+    auto drained = std::make_shared<std::promise<void>>();
+    std::future<void> done = drained->get_future();
+    std::thread([a = async.get(), drained]() { a->drain(); drained->set_value(); }).detach();
+    if (done.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+    {
+        log << "[ASYNC] drain() did not return after throwing callbacks\n";
+        async.release();   // its destructor would wait as well
+        return 1;
+    }
+
+    size_t failures = 0;
+    for (SolveHandle& h : handles)
+    {
+        AsyncResult r = h.get();
+        failures += r.cancelled || !r.sudoku.isSolved();
+    }
+    failures += calls.load() != COUNT;
+    failures += async->failedCallbacks() != COUNT / 2;
+
+    // the workers are still alive
+    SolveHandle after = async->submit(Sudoku());
+    failures += after.get().sudoku.isSolved() ? 0 : 1;
+
+    log << "[ASYNC] " << COUNT << " requests, " << async->failedCallbacks()
+        << " throwing callbacks, drain returned, " << failures << " failures\n";
+    return failures;
+}
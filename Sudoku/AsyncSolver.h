@@ -0,0 +1,97 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <vector>
+#include "ISudokuSolver.h"
+#include "MicroBatcher.h"
+
+struct AsyncOptions
+{
+    BatchOptions batch;            // worker pool and batching
+    size_t maxPending = 4096;      // queued + running requests before submit blocks
+};
+
+struct AsyncResult
+{
+    Sudoku sudoku;                 // solved grid (input grid if cancelled)
+    SolveResult result = SolveResult::Unsolvable;
+    bool cancelled = false;
+    size_t index = 0;              // position in the submitted span
+};
+
+// Handle of one submitted puzzle: wait for / poll the result or cancel it.
+class SolveHandle
+{
+public:
+    SolveHandle() = default;
+
+    // true if the request was still queued; its result then reports cancelled
+    bool cancel();
+
+    bool ready() const;
+    AsyncResult get();             // waits; once per handle
+    const MicroBatcher::Ticket& ticket() const { return state; }
+
+private:
+    friend class AsyncSolver;
+    std::shared_future<AsyncResult> future;
+    MicroBatcher::Ticket state;
+    std::function<void()> onCancel;
+};
+
+// Non-blocking front end for any ISudokuSolver: requests go through a
+// MicroBatcher worker pool (one engine per worker, from the factory) and
+// complete a future and/or a callback.
+// Submitting blocks (submit) or fails (trySubmit) once maxPending requests
+// are in flight.
+//
+// Callbacks run on a worker thread (or the cancelling thread) after the
+// future is ready and the request no longer counts as in flight. They must
+// not block on submit()/submitAll(): with every worker waiting for space the
+// pool cannot make any. Use trySubmit from a callback. An exception thrown
+// by a callback is caught and counted (failedCallbacks).
+class AsyncSolver
+{
+public:
+    using Callback = std::function<void(AsyncResult& result)>;
+
+    // one engine per worker thread, see MicroBatcher
+    explicit AsyncSolver(const MicroBatcher::SolverFactory& factory, const AsyncOptions& options = AsyncOptions());
+    ~AsyncSolver();
+
+    SolveHandle submit(const Sudoku& sudoku, Callback done = nullptr);
+    std::optional<SolveHandle> trySubmit(const Sudoku& sudoku, Callback done = nullptr);
+    std::vector<SolveHandle> submitAll(std::span<const Sudoku> sudokus, Callback done = nullptr);
+
+    // waits until every submitted request completed or was cancelled and
+    // its callback returned
+    void drain();
+
+    size_t pending() const;
+    // callbacks that threw; the exception is caught and counted
+    uint64_t failedCallbacks() const { return failed.load(std::memory_order_relaxed); }
+
+    // Callbacks that throw must neither stop a worker nor leave drain()
+    // waiting: half of a batch of requests throws, then drain() has to return
+    // and the pool still has to answer. Returns the number of failures.
+    static size_t callbackCheck(std::ostream& log);
+
+private:
+    SolveHandle enqueue(const Sudoku& sudoku, size_t index, Callback done);
+    void release(bool callbackFollows);
+    void runCallback(const Callback& done, AsyncResult& result);
+
+    AsyncOptions options;
+    MicroBatcher batcher;
+
+    mutable std::mutex lock;
+    std::condition_variable space;
+    size_t inFlight = 0;
+    size_t callbacks = 0;          // started or about to start, not yet returned
+    std::atomic<uint64_t> failed{ 0 };
+};
@@ -1,19 +1,40 @@
 #include "BacktrackingSolver.h"
 
 SolveResult BacktrackingSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult BacktrackingSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult BacktrackingSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
 {
     // Eer zaten zldyse
     if (sudoku.isSolved())
         return SolveResult::AlreadySolved;
 
-    bool ok = solveRecursive(sudoku);
-    return ok ? SolveResult::SolvedByBacktracking : SolveResult::Unsolvable;
+    BudgetGuard guard(budget);
+    bool ok = solveRecursive(sudoku, search, guard, 0);
+    if (ok)
+        return SolveResult::SolvedByBacktracking;
+    return guard.exceeded() ? SolveResult::BudgetExceeded : SolveResult::Unsolvable;
 }
 
-bool BacktrackingSolver::solveRecursive(Sudoku& sudoku)
+bool BacktrackingSolver::solveRecursive(Sudoku& sudoku, SearchStats& search, BudgetGuard& guard, uint32_t depth)
 {
     uint8_t row, col;
 
+    if (guard.exhausted())
+        return false;
+
+    ++search.nodes;
+    if (depth > search.maxDepth)
+        search.maxDepth = depth;
+
     // Bo hcre yoksa zlmtr
     if (!sudoku.findUnassigned(row, col))
         return true;
@@ -23,12 +44,16 @@ bool BacktrackingSolver::solveRecursive(Sudoku& sudoku)
         if (sudoku.isSafe(row, col, num))
         {
             sudoku.set(row, col, num);
+            ++search.guesses;
 
-            if (solveRecursive(sudoku))
+            if (solveRecursive(sudoku, search, guard, depth + 1))
                 return true;
 
+            ++search.backtracks;
             // Geri al
             sudoku.set(row, col, UNASSIGNED);
+            if (guard.exceeded())
+                return false;
         }
     }
     return false;
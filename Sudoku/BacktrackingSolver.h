@@ -10,7 +10,9 @@ public:
     ~BacktrackingSolver() override = default;
 
     SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
     const char* getName() const override { return "Backtracking Solver"; }
 private:
-    bool solveRecursive(Sudoku& sudoku);
+    bool solveRecursive(Sudoku& sudoku, SearchStats& search, BudgetGuard& guard, uint32_t depth);
 };
\ No newline at end of file
@@ -1,19 +1,45 @@
 #include "BacktrackingSolverMRV.h"
 
+#include <algorithm>
+
 SolveResult BacktrackingSolverMRV::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult BacktrackingSolverMRV::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult BacktrackingSolverMRV::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
 {
     // Entry-point davran BacktrackingSolver ile AYNI
     if (sudoku.isSolved())
         return SolveResult::AlreadySolved;
 
-    bool ok = solveRecursive(sudoku);
-    return ok ? SolveResult::SolvedByBacktracking : SolveResult::Unsolvable;
+    if (!options.classic())
+        return solveOrdered(sudoku, search, budget);
+
+    BudgetGuard guard(budget);
+    bool ok = solveRecursive(sudoku, search, guard, 0);
+    if (ok)
+        return SolveResult::SolvedByBacktracking;
+    return guard.exceeded() ? SolveResult::BudgetExceeded : SolveResult::Unsolvable;
 }
 
-bool BacktrackingSolverMRV::solveRecursive(Sudoku& sudoku)
+bool BacktrackingSolverMRV::solveRecursive(Sudoku& sudoku, SearchStats& search, BudgetGuard& guard, uint32_t depth)
 {
     uint8_t row, col;
 
+    if (guard.exhausted())
+        return false;
+
+    ++search.nodes;
+    if (depth > search.maxDepth)
+        search.maxDepth = depth;
+
     // MRV ile hcre seimi
     if (!sudoku.findCellWithMRV(row, col))
     {
@@ -27,14 +53,269 @@ bool BacktrackingSolverMRV::solveRecursive(Sudoku& sudoku)
         if (sudoku.isSafe(row, col, num))
         {
             sudoku.set(row, col, num);
+            ++search.guesses;
 
-            if (solveRecursive(sudoku))
+            if (solveRecursive(sudoku, search, guard, depth + 1))
                 return true;
 
+            ++search.backtracks;
             // geri al
             sudoku.set(row, col, UNASSIGNED);
+            if (guard.exceeded())
+                return false;
         }
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+/* ============================================================
+   ORDERED SEARCH (value ordering, random ties, restarts)
+   ============================================================ */
+namespace {
+
+struct SplitMix
+{
+    uint64_t state;
+
+    uint64_t next()
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t below(uint32_t n) { return (uint32_t)(((next() >> 32) * n) >> 32); }
+};
+
+// 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ... (i starting at 0)
+uint64_t luby(uint64_t i)
+{
+    uint64_t size = 1, seq = 0;
+    while (size < i + 1)
+    {
+        ++seq;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i)
+    {
+        size = (size - 1) >> 1;
+        --seq;
+        i %= size;
+    }
+    return 1ull << seq;
+}
+
+// Works on the grid in place with per-unit digit masks kept up to date,
+// so a node costs one 81-cell scan instead of 9 isSafe calls per cell.
+struct OrderedSearch
+{
+    uint8_t* grid;
+    uint16_t used[UNIT_COUNT] = {};
+    uint8_t digitCount[NUMBER_COUNT + 1] = {};
+    const MRVOptions& options;
+    bool randomTies;
+    SplitMix rng;
+    SearchStats& search;
+
+    OrderedSearch(Sudoku& sudoku, const MRVOptions& o, SearchStats& s)
+        : grid(sudoku.rawGridMutable()), options(o), randomTies(o.randomTies || o.restartUnit),
+          rng{ o.seed }, search(s)
+    {
+        for (int i = 0; i < 81; ++i)
+            rng.state = rng.state * 31 + grid[i];
+    }
+
+    bool load()
+    {
+        for (int i = 0; i < 81; ++i)
+        {
+            uint8_t v = grid[i];
+            if (v == UNASSIGNED)
+                continue;
+            const uint8_t* u = UNITS.ofCell[i];
+            if ((used[u[0]] | used[u[1]] | used[u[2]]) & bit(v))
+                return false;
+            used[u[0]] |= bit(v);
+            used[u[1]] |= bit(v);
+            used[u[2]] |= bit(v);
+            ++digitCount[v];
+        }
+        return true;
+    }
+
+    uint16_t candidates(int i) const
+    {
+        const uint8_t* u = UNITS.ofCell[i];
+        return FULL_MASK & ~(used[u[0]] | used[u[1]] | used[u[2]]);
+    }
+
+    void place(int i, uint8_t v)
+    {
+        const uint8_t* u = UNITS.ofCell[i];
+        used[u[0]] |= bit(v);
+        used[u[1]] |= bit(v);
+        used[u[2]] |= bit(v);
+        ++digitCount[v];
+        grid[i] = v;
+    }
+
+    void unplace(int i)
+    {
+        uint8_t v = grid[i];
+        const uint8_t* u = UNITS.ofCell[i];
+        used[u[0]] &= (uint16_t)~bit(v);
+        used[u[1]] &= (uint16_t)~bit(v);
+        used[u[2]] &= (uint16_t)~bit(v);
+        --digitCount[v];
+        grid[i] = UNASSIGNED;
+    }
+
+    // empty peers that still allow v (peers sharing two units count twice)
+    int constrains(int cell, uint8_t v) const
+    {
+        int n = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            const uint8_t* unit = UNITS.cells[UNITS.ofCell[cell][k]];
+            for (int j = 0; j < NUMBER_COUNT; ++j)
+            {
+                int peer = unit[j];
+                if (peer != cell && grid[peer] == UNASSIGNED && (candidates(peer) & bit(v)))
+                    ++n;
+            }
+        }
+        return n;
+    }
+
+    // -1: dead end, 0: solved, 1: branch on 'cell'
+    int selectCell(int& cell)
+    {
+        int bestCount = 10, ties = 0;
+        cell = -1;
+        for (int i = 0; i < 81; ++i)
+        {
+            if (grid[i] != UNASSIGNED)
+                continue;
+            int n = std::popcount(candidates(i));
+            if (n == 0)
+                return -1;
+            if (n < bestCount)
+            {
+                bestCount = n;
+                cell = i;
+                ties = 1;
+                if (n == 1)
+                    break;
+            }
+            else if (n == bestCount && randomTies && rng.below(++ties) == 0)
+                cell = i;   // reservoir sampling over equal cells
+        }
+        return cell < 0 ? 0 : 1;
+    }
+
+    int orderValues(int cell, uint8_t* values)
+    {
+        int n = 0;
+        for (uint16_t m = candidates(cell); m; m &= m - 1)
+            values[n++] = (uint8_t)(std::countr_zero(m) + 1);
+        if (n < 2)
+            return n;
+
+        if (randomTies)
+            for (int i = n - 1; i > 0; --i)
+                std::swap(values[i], values[rng.below((uint32_t)i + 1)]);
+        if (options.valueOrder == MRVOptions::ValueOrder::Ascending)
+            return n;
+
+        int score[NUMBER_COUNT + 1] = {};
+        for (int k = 0; k < n; ++k)
+            score[values[k]] = options.valueOrder == MRVOptions::ValueOrder::LeastConstraining
+                ? constrains(cell, values[k])
+                : -(int)digitCount[values[k]];
+
+        // stable insertion sort: equal scores keep their (shuffled) order
+        for (int i = 1; i < n; ++i)
+            for (int j = i; j > 0 && score[values[j]] < score[values[j - 1]]; --j)
+                std::swap(values[j], values[j - 1]);
+        return n;
+    }
+
+    bool solve(BudgetGuard& guard, uint32_t depth)
+    {
+        if (guard.exhausted())
+            return false;
+
+        ++search.nodes;
+        if (depth > search.maxDepth)
+            search.maxDepth = depth;
+
+        int cell;
+        int state = selectCell(cell);
+        if (state <= 0)
+            return state == 0;
+
+        uint8_t values[NUMBER_COUNT];
+        int n = orderValues(cell, values);
+        for (int k = 0; k < n; ++k)
+        {
+            place(cell, values[k]);
+            ++search.guesses;
+
+            if (solve(guard, depth + 1))
+                return true;
+
+            ++search.backtracks;
+            unplace(cell);
+            if (guard.exceeded())
+                return false;
+        }
+        return false;
+    }
+};
+
+}
+
+SolveResult BacktrackingSolverMRV::solveOrdered(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+{
+    OrderedSearch s(sudoku, options, search);
+    if (!s.load())
+        return SolveResult::Unsolvable;
+
+    if (!options.restartUnit)
+    {
+        BudgetGuard guard(budget);
+        if (s.solve(guard, 0))
+            return SolveResult::SolvedByBacktracking;
+        return guard.exceeded() ? SolveResult::BudgetExceeded : SolveResult::Unsolvable;
+    }
+
+    // every run unwinds completely, so the next one starts from the input
+    uint64_t spent = 0;
+    for (uint64_t run = 0;; ++run)
+    {
+        SolveBudget runBudget = budget;
+        runBudget.maxNodes = options.restartUnit * luby(run);
+        if (budget.maxNodes)
+        {
+            if (spent >= budget.maxNodes)
+                return SolveResult::BudgetExceeded;
+            runBudget.maxNodes = std::min(runBudget.maxNodes, budget.maxNodes - spent);
+        }
+
+        BudgetGuard guard(runBudget);
+        uint64_t before = search.nodes;
+        bool ok = s.solve(guard, 0);
+        spent += search.nodes - before;
+
+        if (ok)
+            return SolveResult::SolvedByBacktracking;
+        if (!guard.exceeded())
+            return SolveResult::Unsolvable;   // the run was exhaustive
+        if ((budget.maxNodes && spent >= budget.maxNodes) ||
+            (budget.deadline != SolveBudget::Clock::time_point{} && SolveBudget::Clock::now() >= budget.deadline))
+            return SolveResult::BudgetExceeded;
+        ++search.restarts;
+    }
+}
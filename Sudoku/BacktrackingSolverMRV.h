@@ -3,11 +3,39 @@
 #include "ISudokuSolver.h"
 #include "Sudoku.h"
 
+struct MRVOptions
+{
+    // Ascending: 1..9. LeastConstraining: values that remove the fewest
+    // candidates from empty peers first. DigitFrequency: digits already
+    // placed most often first (fewest places left).
+    enum class ValueOrder { Ascending, LeastConstraining, DigitFrequency };
+
+    ValueOrder valueOrder = ValueOrder::Ascending;
+    bool randomTies = false;     // random choice among equal cells / values
+    // Luby restarts: run i may expand restartUnit * luby(i) nodes before the
+    // search starts over with fresh random ties (0 = never restart).
+    // Restarts imply randomTies.
+    uint64_t restartUnit = 0;
+    uint64_t seed = 1;           // mixed with the puzzle, so runs are reproducible
+
+    bool classic() const { return valueOrder == ValueOrder::Ascending && !randomTies && !restartUnit; }
+};
+
 class BacktrackingSolverMRV : public ISudokuSolver
 {
 public:
+    BacktrackingSolverMRV() = default;
+    explicit BacktrackingSolverMRV(const MRVOptions& opts) : options(opts) {}
+
+    const MRVOptions& getOptions() const { return options; }
+
     SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
     const char* getName() const override { return "BacktrackingMRV Solver"; }
 private:
-    bool solveRecursive(Sudoku& sudoku);
+    bool solveRecursive(Sudoku& sudoku, SearchStats& search, BudgetGuard& guard, uint32_t depth);
+    SolveResult solveOrdered(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget);
+
+    MRVOptions options;
 };
\ No newline at end of file
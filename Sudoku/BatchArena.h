@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for batch staging buffers. allocate() carves from the
+// current block; reset() rewinds without freeing. When a batch needs more
+// than the capacity, a bigger block is chained on and the next reset()
+// merges everything into one block of the high-water size. After the first
+// batch of the largest size, a steady batch loop does no heap allocation.
+//
+// Memory is uninitialized. Only trivially destructible types: nothing is
+// destroyed on reset.
+class BatchArena
+{
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit BatchArena(size_t initialBytes = 0)
+    {
+        if (initialBytes)
+            addBlock(initialBytes);
+    }
+
+    template<class T>
+    T* allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "BatchArena does not run destructors");
+        size_t bytes = (count * sizeof(T) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (blocks.empty() || used + bytes > blocks.back().size)
+            addBlock(std::max(bytes, blocks.empty() ? bytes : blocks.back().size * 2));
+        T* p = reinterpret_cast<T*>(blocks.back().data.get() + used);
+        used += bytes;
+        return p;
+    }
+
+    void reset()
+    {
+        if (blocks.size() > 1)
+        {
+            size_t total = 0;
+            for (const Block& b : blocks)
+                total += b.size;
+            blocks.clear();
+            addBlock(total);
+        }
+        used = 0;
+    }
+
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const Block& b : blocks)
+            total += b.size;
+        return total;
+    }
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(uint8_t* p) const { ::operator delete[](p, std::align_val_t(ALIGNMENT)); }
+    };
+
+    struct Block
+    {
+        std::unique_ptr<uint8_t[], AlignedDelete> data;
+        size_t size = 0;
+    };
+
+    void addBlock(size_t bytes)
+    {
+        Block b;
+        b.data.reset(static_cast<uint8_t*>(::operator new[](bytes, std::align_val_t(ALIGNMENT))));
+        b.size = bytes;
+        blocks.push_back(std::move(b));
+        used = 0;
+    }
+
+    std::vector<Block> blocks;
+    size_t used = 0;
+};
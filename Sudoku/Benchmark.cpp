@@ -0,0 +1,407 @@
+#include "Benchmark.h"
+#include "DatasetLoader.h"
+#include "ParallelSolver.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+/* ============================================================
+   SAMPLE STATS
+   ============================================================ */
+double BenchmarkSample::meanNs() const
+{
+    if (repNs.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : repNs) sum += v;
+    return sum / (double)repNs.size();
+}
+
+double BenchmarkSample::stddevNs() const
+{
+    if (repNs.size() < 2) return 0.0;
+    double mean = meanNs();
+    double sq = 0.0;
+    for (double v : repNs) sq += (v - mean) * (v - mean);
+    return std::sqrt(sq / (double)(repNs.size() - 1));
+}
+
+double BenchmarkSample::minNs() const
+{
+    return repNs.empty() ? 0.0 : *std::min_element(repNs.begin(), repNs.end());
+}
+
+double BenchmarkSample::maxNs() const
+{
+    return repNs.empty() ? 0.0 : *std::max_element(repNs.begin(), repNs.end());
+}
+
+/* ============================================================
+   RUN
+   ============================================================ */
+static SolveStats solveDataset(ISudokuSolver& solver, std::vector<Sudoku>& dataset,
+    unsigned threads, LatencyReport* latency)
+{
+    if (threads > 1)
+        return ParallelSolver::solveAll(solver, dataset, threads, latency);
+    if (latency)
+        return LatencyReport::solveAll(solver, dataset, *latency);
+    return solver.solveAll(dataset);
+}
+
+std::vector<BenchmarkSample> Benchmark::run(
+    const BenchmarkConfig& config,
+    const std::vector<std::vector<Sudoku>>& datasets,
+    const std::vector<int>& ids)
+{
+    std::vector<BenchmarkSample> samples;
+
+    for (const std::string& name : config.solvers)
+    {
+        for (unsigned threads : config.threads)
+        {
+            std::unique_ptr<ISudokuSolver> solver = SolverRegistry::create(name);
+            if (!solver)
+                throw std::runtime_error("Unknown solver: " + name);
+            solver = BudgetedSolver::wrap(std::move(solver), config.budget, config.escalate);
+
+            std::cout << "[BENCH] " << name << " threads=" << threads << std::endl;
+
+            // one sample per dataset, plus the total over all of them
+            size_t first = samples.size();
+            for (size_t d = 0; d <= datasets.size(); ++d)
+            {
+                BenchmarkSample s;
+                // puzzle indices are per dataset, the total keeps only percentiles
+                s.latency = LatencyReport(d < datasets.size() ? config.slowest : 0);
+                s.solver = name;
+                s.threads = threads;
+                s.dataset = d < datasets.size() ? ids[d] : -1;
+                samples.push_back(s);
+            }
+            BenchmarkSample& total = samples.back();
+
+            for (int rep = -config.warmup; rep < config.repetitions; ++rep)
+            {
+                double totalNs = 0.0;
+                SolveStats totalStats;
+
+                for (size_t d = 0; d < datasets.size(); ++d)
+                {
+                    // copy is outside the timed region
+                    std::vector<Sudoku> work = datasets[d];
+                    BenchmarkSample& s = samples[first + d];
+                    LatencyReport* latency = config.latency && rep >= 0 ? &s.latency : nullptr;
+
+                    Clock::time_point t0 = Clock::now();
+                    SolveStats st = solveDataset(*solver, work, threads, latency);
+                    Clock::time_point t1 = Clock::now();
+
+                    double ns = (double)std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(t1 - t0).count();
+
+                    totalNs += ns;
+                    totalStats.merge(st);
+
+                    if (rep < 0) continue; // warmup
+                    s.puzzles = work.size();
+                    s.repNs.push_back(ns);
+                    s.stats = st;
+                }
+
+                if (rep < 0) continue;
+                total.puzzles = totalStats.total();
+                total.repNs.push_back(totalNs);
+                total.stats = totalStats;
+            }
+
+            if (config.latency)
+                for (size_t d = 0; d < datasets.size(); ++d)
+                    total.latency.merge(samples[first + d].latency);
+        }
+    }
+    return samples;
+}
+
+/* ============================================================
+   OUTPUT
+   ============================================================ */
+static void writeLatencyJson(std::ostream& os, const char* name,
+    const LatencyHistogram& h, const char* indent)
+{
+    os << indent << "  \"" << name << "\": { \"count\": " << h.count()
+        << ", \"p50\": " << h.percentile(50)
+        << ", \"p90\": " << h.percentile(90)
+        << ", \"p99\": " << h.percentile(99)
+        << ", \"p999\": " << h.percentile(99.9)
+        << ", \"max\": " << h.max() << " }";
+}
+
+static void writeSampleJson(std::ostream& os, const BenchmarkSample& s, const char* indent)
+{
+    double mean = s.meanNs();
+    os << indent << "\"puzzles\": " << s.puzzles << ",\n"
+        << indent << "\"repetitions_ns\": [";
+    for (size_t i = 0; i < s.repNs.size(); ++i)
+        os << (i ? ", " : "") << (long long)s.repNs[i];
+    os << "],\n"
+        << indent << "\"mean_ns\": " << (long long)mean << ",\n"
+        << indent << "\"stddev_ns\": " << (long long)s.stddevNs() << ",\n"
+        << indent << "\"rel_stddev\": " << (mean > 0 ? s.stddevNs() / mean : 0.0) << ",\n"
+        << indent << "\"min_ns\": " << (long long)s.minNs() << ",\n"
+        << indent << "\"max_ns\": " << (long long)s.maxNs() << ",\n"
+        << indent << "\"ns_per_puzzle\": " << s.nsPerPuzzle() << ",\n"
+        << indent << "\"puzzles_per_sec\": " << s.puzzlesPerSec() << ",\n"
+        << indent << "\"already_solved\": " << s.stats.alreadySolved << ",\n"
+        << indent << "\"logical\": " << s.stats.logical << ",\n"
+        << indent << "\"backtracking\": " << s.stats.backtracking << ",\n"
+        << indent << "\"unsolvable\": " << s.stats.unsolvable << ",\n"
+        << indent << "\"budget_exceeded\": " << s.stats.budgetExceeded << ",\n"
+        << indent << "\"search_nodes\": " << s.stats.search.nodes << ",\n"
+        << indent << "\"search_guesses\": " << s.stats.search.guesses << ",\n"
+        << indent << "\"search_backtracks\": " << s.stats.search.backtracks << ",\n"
+        << indent << "\"search_max_depth\": " << s.stats.search.maxDepth;
+
+    if (s.latency.overall().count())
+    {
+        os << ",\n" << indent << "\"latency_ns\": {\n";
+        writeLatencyJson(os, "all", s.latency.overall(), indent);
+        for (size_t r = 0; r < LatencyReport::RESULT_COUNT; ++r)
+        {
+            const LatencyHistogram& h = s.latency.byResult((SolveResult)r);
+            if (!h.count()) continue;
+            os << ",\n";
+            writeLatencyJson(os, solveResultName((SolveResult)r), h, indent);
+        }
+        os << "\n" << indent << "}";
+
+        std::vector<SlowPuzzle> top = s.latency.slowest();
+        if (!top.empty())
+        {
+            os << ",\n" << indent << "\"slowest\": [";
+            for (size_t i = 0; i < top.size(); ++i)
+                os << (i ? ", " : "") << "{ \"index\": " << top[i].index
+                    << ", \"ns\": " << top[i].ns
+                    << ", \"result\": \"" << solveResultName(top[i].result) << "\" }";
+            os << "]";
+        }
+    }
+    os << "\n";
+}
+
+void Benchmark::writeJson(std::ostream& os, const BenchmarkConfig& config,
+    const std::vector<BenchmarkSample>& samples)
+{
+    long long unixTime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\n"
+        << "  \"unix_time\": " << unixTime << ",\n"
+        << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"repetitions\": " << config.repetitions << ",\n"
+        << "  \"warmup\": " << config.warmup << ",\n"
+        << "  \"runs\": [\n";
+
+    // samples are grouped per (solver, threads), total last
+    bool firstRun = true;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const BenchmarkSample& s = samples[i];
+        if (s.dataset == -1) continue;
+
+        bool runStart = i == 0 || samples[i - 1].dataset == -1;
+        if (runStart)
+        {
+            os << (firstRun ? "" : ",\n")
+                << "    {\n"
+                << "      \"solver\": \"" << s.solver << "\",\n"
+                << "      \"threads\": " << s.threads << ",\n"
+                << "      \"datasets\": [\n";
+            firstRun = false;
+        }
+        else
+            os << ",\n";
+
+        os << "        {\n"
+            << "          \"dataset\": " << s.dataset << ",\n";
+        writeSampleJson(os, s, "          ");
+        os << "        }";
+
+        if (i + 1 < samples.size() && samples[i + 1].dataset == -1)
+        {
+            os << "\n      ],\n"
+                << "      \"total\": {\n";
+            writeSampleJson(os, samples[i + 1], "        ");
+            os << "      }\n"
+                << "    }";
+        }
+    }
+    os << "\n  ]\n}\n";
+}
+
+void Benchmark::writeCsv(std::ostream& os, const std::vector<BenchmarkSample>& samples)
+{
+    os << std::fixed << std::setprecision(3);
+    os << "solver,threads,dataset,puzzles,repetitions,mean_ns,stddev_ns,min_ns,max_ns,"
+        "ns_per_puzzle,puzzles_per_sec,already_solved,logical,backtracking,unsolvable,budget_exceeded,"
+        "search_nodes,search_guesses,search_backtracks,search_max_depth,"
+        "p50_ns,p90_ns,p99_ns,p999_ns,max_ns_puzzle\n";
+
+    for (const BenchmarkSample& s : samples)
+    {
+        os << s.solver << ',' << s.threads << ','
+            << (s.dataset < 0 ? std::string("all") : std::to_string(s.dataset)) << ','
+            << s.puzzles << ',' << s.repNs.size() << ','
+            << (long long)s.meanNs() << ',' << (long long)s.stddevNs() << ','
+            << (long long)s.minNs() << ',' << (long long)s.maxNs() << ','
+            << s.nsPerPuzzle() << ',' << s.puzzlesPerSec() << ','
+            << s.stats.alreadySolved << ',' << s.stats.logical << ','
+            << s.stats.backtracking << ',' << s.stats.unsolvable << ','
+            << s.stats.budgetExceeded << ','
+            << s.stats.search.nodes << ',' << s.stats.search.guesses << ','
+            << s.stats.search.backtracks << ',' << s.stats.search.maxDepth << ',';
+
+        const LatencyHistogram& h = s.latency.overall();
+        if (h.count())
+            os << h.percentile(50) << ',' << h.percentile(90) << ',' << h.percentile(99) << ','
+                << h.percentile(99.9) << ',' << h.max() << '\n';
+        else
+            os << ",,,,\n";
+    }
+}
+
+/* ============================================================
+   COMMAND
+   ============================================================ */
+void Benchmark::printUsage(std::ostream& os)
+{
+    os << "Usage: Sudoku bench [options]\n"
+        << "  --solvers a,b       engines to run (default: logical,logical-simd)\n"
+        << "  --datasets 0,1,5    dataset indices (default: all)\n"
+        << "  --dataset-root DIR  folder containing Dataset0..5 (default: Dataset)\n"
+        << "  --threads 1,8       thread counts, 1 = sequential (default: 1)\n"
+        << "  --reps N            timed repetitions (default: 5)\n"
+        << "  --warmup N          untimed repetitions first (default: 1)\n"
+        << "  --max N             puzzles per dataset (default: all)\n"
+        << "  --format json|csv   report format (default: json)\n"
+        << "  --out FILE          report file (default: bench_results.<format>)\n"
+        << "  --latency           per-puzzle percentiles (p50/p90/p99/p99.9/max)\n"
+        << "  --slowest N         slowest puzzle ids kept per dataset (default: 10)\n"
+        << BudgetedSolver::usage()
+        << "Solvers:";
+    for (const std::string& n : SolverRegistry::names())
+        os << ' ' << n;
+    os << "\n  (cached-<solver> adds the canonical result cache, stored-<solver> the\n"
+        << "   persistent solution store; the warmup repetition fills both)\n";
+}
+
+int Benchmark::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    BenchmarkConfig config;
+    if (cmd.has("solvers"))
+        config.solvers = cmd.getList("solvers");
+    for (long long d : cmd.getIntList("datasets"))
+        config.datasets.push_back((int)d);
+    if (cmd.has("threads"))
+    {
+        config.threads.clear();
+        for (long long t : cmd.getIntList("threads"))
+            config.threads.push_back((unsigned)std::max(1LL, t));
+    }
+    config.repetitions = (int)std::max(1LL, cmd.getInt("reps", config.repetitions));
+    config.warmup = (int)std::max(0LL, cmd.getInt("warmup", config.warmup));
+    if (cmd.has("max"))
+        config.maxPerDataset = (size_t)std::max(1LL, cmd.getInt("max", 0));
+    config.datasetRoot = cmd.get("dataset-root", config.datasetRoot);
+    config.format = cmd.get("format", config.format);
+    config.outPath = cmd.get("out", "bench_results." + config.format);
+    config.latency = cmd.has("latency");
+    config.slowest = (size_t)std::max(0LL, cmd.getInt("slowest", (long long)config.slowest));
+    config.budget = BudgetOptions::fromCommandLine(cmd);
+    config.escalate = cmd.get("escalate");
+
+    if (config.format != "json" && config.format != "csv")
+    {
+        std::cerr << "Unknown format: " << config.format << "\n";
+        return 2;
+    }
+    for (const std::string& name : config.solvers)
+        if (!SolverRegistry::create(name))
+        {
+            std::cerr << "Unknown solver: " << name << "\n";
+            printUsage(std::cerr);
+            return 2;
+        }
+    if (!config.escalate.empty() && !SolverRegistry::create(config.escalate))
+    {
+        std::cerr << "Unknown escalation solver: " << config.escalate << "\n";
+        return 2;
+    }
+
+    if (config.datasets.empty())
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            config.datasets.push_back(d);
+
+    std::vector<std::vector<Sudoku>> datasets;
+    for (int d : config.datasets)
+        datasets.push_back(DatasetLoader::loadSingleDataset(
+            DatasetLoader::datasetFolder(config.datasetRoot, d), config.maxPerDataset));
+
+    std::vector<BenchmarkSample> samples = run(config, datasets, config.datasets);
+
+    std::ofstream out(config.outPath);
+    if (!out)
+    {
+        std::cerr << "Cannot write " << config.outPath << "\n";
+        return 1;
+    }
+    if (config.format == "json")
+        writeJson(out, config, samples);
+    else
+        writeCsv(out, samples);
+
+    // human-readable summary
+    std::cout << "\n" << std::left
+        << std::setw(22) << "solver" << std::setw(9) << "threads"
+        << std::setw(9) << "dataset" << std::setw(10) << "puzzles"
+        << std::setw(14) << "ns/puzzle" << std::setw(14) << "puzzles/s"
+        << "stddev\n";
+    for (const BenchmarkSample& s : samples)
+    {
+        double mean = s.meanNs();
+        std::cout << std::setw(22) << s.solver << std::setw(9) << s.threads
+            << std::setw(9) << (s.dataset < 0 ? std::string("all") : std::to_string(s.dataset))
+            << std::setw(10) << s.puzzles
+            << std::setw(14) << std::fixed << std::setprecision(0) << s.nsPerPuzzle()
+            << std::setw(14) << s.puzzlesPerSec()
+            << std::setprecision(1) << (mean > 0 ? 100.0 * s.stddevNs() / mean : 0.0) << "%\n";
+    }
+    if (config.latency)
+    {
+        std::cout << "\n";
+        for (const BenchmarkSample& s : samples)
+        {
+            std::string title = s.solver + " x" + std::to_string(s.threads) + " " +
+                (s.dataset < 0 ? std::string("all") : "Dataset" + std::to_string(s.dataset));
+            s.latency.print(std::cout, title.c_str());
+        }
+    }
+    std::cout << "\n[BENCH] Report written to " << config.outPath << "\n";
+    return 0;
+}
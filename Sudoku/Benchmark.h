@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "BudgetedSolver.h"
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+#include "LatencyHistogram.h"
+
+struct BenchmarkConfig
+{
+    std::vector<std::string> solvers = { "logical", "logical-simd" };
+    std::vector<int> datasets;              // empty = all
+    std::vector<unsigned> threads = { 1 };  // 1 = sequential solveAll
+    int repetitions = 5;
+    int warmup = 1;
+    size_t maxPerDataset = SIZE_MAX;
+    std::string datasetRoot = "Dataset";
+    std::string format = "json";            // json | csv
+    std::string outPath;                    // default: bench_results.<format>
+    bool latency = false;                   // per-puzzle timing of the timed repetitions
+    size_t slowest = 10;                    // slowest puzzle ids kept per dataset
+    BudgetOptions budget;                   // per-puzzle search budget (none by default)
+    std::string escalate;                   // engine for puzzles over budget ("" = report them)
+};
+
+// One (solver, threads, dataset) measurement over all repetitions.
+struct BenchmarkSample
+{
+    std::string solver;
+    unsigned threads = 1;
+    int dataset = -1;                       // -1 = all selected datasets
+    size_t puzzles = 0;
+    std::vector<double> repNs;              // wall time of each repetition
+    SolveStats stats;                       // result mix of the last repetition
+    LatencyReport latency;                  // filled when config.latency
+
+    double meanNs() const;
+    double stddevNs() const;
+    double minNs() const;
+    double maxNs() const;
+    double nsPerPuzzle() const { return puzzles ? meanNs() / (double)puzzles : 0.0; }
+    double puzzlesPerSec() const { return meanNs() > 0 ? (double)puzzles * 1e9 / meanNs() : 0.0; }
+};
+
+// "bench" command: repeatable throughput measurement of any registered
+// engine with JSON / CSV output.
+class Benchmark
+{
+public:
+    static int runCommand(const CommandLine& cmd);
+    static void printUsage(std::ostream& os);
+
+    // datasets[i] is reported as dataset ids[i]
+    static std::vector<BenchmarkSample> run(
+        const BenchmarkConfig& config,
+        const std::vector<std::vector<Sudoku>>& datasets,
+        const std::vector<int>& ids);
+
+    static void writeJson(std::ostream& os, const BenchmarkConfig& config,
+        const std::vector<BenchmarkSample>& samples);
+    static void writeCsv(std::ostream& os, const std::vector<BenchmarkSample>& samples);
+};
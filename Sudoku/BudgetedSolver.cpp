@@ -0,0 +1,84 @@
+#include "BudgetedSolver.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+BudgetOptions BudgetOptions::fromCommandLine(const CommandLine& cmd)
+{
+    BudgetOptions o;
+    o.maxNodes = (uint64_t)std::max(0LL, cmd.getInt("node-budget", 0));
+    o.timeLimit = std::chrono::microseconds(std::max(0LL, cmd.getInt("time-budget-us", 0)));
+    return o;
+}
+
+BudgetedSolver::BudgetedSolver(std::unique_ptr<ISudokuSolver> innerSolver, const BudgetOptions& opts,
+    std::unique_ptr<ISudokuSolver> escalationSolver)
+    : inner(std::move(innerSolver)), escalation(std::move(escalationSolver)), options(opts)
+{
+    name = std::string("Budgeted ") + inner->getName();
+    if (escalation)
+        name += std::string(" -> ") + escalation->getName();
+}
+
+SolveResult BudgetedSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult BudgetedSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult BudgetedSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& outer)
+{
+    SolveBudget budget = SolveBudget::of(options.maxNodes, options.timeLimit);
+    if (outer.maxNodes && (!budget.maxNodes || outer.maxNodes < budget.maxNodes))
+        budget.maxNodes = outer.maxNodes;
+    if (outer.deadline != SolveBudget::Clock::time_point{} &&
+        (budget.deadline == SolveBudget::Clock::time_point{} || outer.deadline < budget.deadline))
+        budget.deadline = outer.deadline;
+
+    // the search unwinds its guesses, so on BudgetExceeded the grid holds
+    // the input plus whatever the logical phase placed: a valid restart point
+    SolveResult r = inner->solveWithBudget(sudoku, search, budget);
+    if (r != SolveResult::BudgetExceeded)
+        return r;
+
+    exceeded.fetch_add(1, std::memory_order_relaxed);
+    if (!escalation)
+        return r;
+
+    escalated.fetch_add(1, std::memory_order_relaxed);
+    return escalation->solveWithBudget(sudoku, search, outer);
+}
+
+std::unique_ptr<ISudokuSolver> BudgetedSolver::wrap(std::unique_ptr<ISudokuSolver> inner,
+    const BudgetOptions& options, const std::string& escalate)
+{
+    if (!inner || !options.limited())
+        return inner;
+
+    std::unique_ptr<ISudokuSolver> escalation;
+    if (!escalate.empty())
+    {
+        escalation = SolverRegistry::create(escalate);
+        if (!escalation)
+            throw std::runtime_error("Unknown escalation solver: " + escalate);
+    }
+    return std::unique_ptr<ISudokuSolver>(new BudgetedSolver(std::move(inner), options, std::move(escalation)));
+}
+
+std::unique_ptr<ISudokuSolver> BudgetedSolver::wrap(std::unique_ptr<ISudokuSolver> inner, const CommandLine& cmd)
+{
+    return wrap(std::move(inner), BudgetOptions::fromCommandLine(cmd), cmd.get("escalate"));
+}
+
+const char* BudgetedSolver::usage()
+{
+    return "  --node-budget N     give up a puzzle after N search nodes\n"
+           "  --time-budget-us N  give up a puzzle after N microseconds\n"
+           "  --escalate NAME     re-solve puzzles that ran out with NAME, unbounded\n";
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+
+struct BudgetOptions
+{
+    uint64_t maxNodes = 0;                      // 0 = unlimited
+    std::chrono::microseconds timeLimit{ 0 };   // 0 = unlimited
+
+    bool limited() const { return maxNodes || timeLimit.count() > 0; }
+
+    // --node-budget N --time-budget-us N
+    static BudgetOptions fromCommandLine(const CommandLine& cmd);
+};
+
+// Runs the inner engine under a per-solve node / time budget so a single
+// adversarial puzzle cannot hold a worker for seconds. Puzzles that run out
+// are either reported as BudgetExceeded or, with an escalation engine,
+// solved again by it without a budget.
+class BudgetedSolver : public ISudokuSolver
+{
+public:
+    BudgetedSolver(std::unique_ptr<ISudokuSolver> inner, const BudgetOptions& options,
+        std::unique_ptr<ISudokuSolver> escalation = nullptr);
+
+    SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    // the tighter of both budgets applies
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
+    const char* getName() const override { return name.c_str(); }
+
+    uint64_t exceededCount() const { return exceeded.load(std::memory_order_relaxed); }
+    uint64_t escalatedCount() const { return escalated.load(std::memory_order_relaxed); }
+
+    // Wraps 'inner' if a budget is set, otherwise returns it unchanged.
+    // escalate = registry name of the escalation engine ("" = none).
+    static std::unique_ptr<ISudokuSolver> wrap(std::unique_ptr<ISudokuSolver> inner,
+        const BudgetOptions& options, const std::string& escalate);
+    // same from --node-budget / --time-budget-us / --escalate
+    static std::unique_ptr<ISudokuSolver> wrap(std::unique_ptr<ISudokuSolver> inner, const CommandLine& cmd);
+
+    static const char* usage();
+
+private:
+    std::unique_ptr<ISudokuSolver> inner;
+    std::unique_ptr<ISudokuSolver> escalation;
+    BudgetOptions options;
+    std::string name;
+
+    std::atomic<uint64_t> exceeded{ 0 };
+    std::atomic<uint64_t> escalated{ 0 };
+};
@@ -0,0 +1,415 @@
+#include "CDCLSolver.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr int VAR_COUNT = NUMBER_COUNT * NUMBER_COUNT * NUMBER_COUNT;   // 729
+constexpr uint32_t NO_REASON = UINT32_MAX;
+constexpr uint32_t NO_LIT = UINT32_MAX;
+
+enum : uint8_t { L_FALSE = 0, L_TRUE = 1, L_UNDEF = 2 };
+
+// literal = 2 * var + negated, var = cell * 9 + (digit - 1)
+inline uint32_t mkLit(int var, bool negated) { return (uint32_t)(var * 2 + (negated ? 1 : 0)); }
+inline int litVar(uint32_t lit) { return (int)(lit >> 1); }
+inline int cellVar(int cell, int digitIndex) { return cell * NUMBER_COUNT + digitIndex; }
+
+// CNF of the empty grid, built once. Clause layout in the arena:
+// [size, lit0, lit1, ...]
+struct Watcher
+{
+    uint32_t cref;
+    uint32_t blocker;   // some other literal of the clause; true = skip the clause
+};
+
+struct BaseFormula
+{
+    std::vector<uint32_t> arena;
+    std::vector<std::vector<Watcher>> watches;   // by literal: clauses watching it
+
+    void add(const uint32_t* lits, int n)
+    {
+        uint32_t cref = (uint32_t)arena.size();
+        watches[lits[0]].push_back({ cref, lits[1] });
+        watches[lits[1]].push_back({ cref, lits[0] });
+        arena.push_back((uint32_t)n);
+        arena.insert(arena.end(), lits, lits + n);
+    }
+
+    void exactlyOne(const int* vars)
+    {
+        uint32_t lits[NUMBER_COUNT];
+        for (int i = 0; i < NUMBER_COUNT; ++i)
+            lits[i] = mkLit(vars[i], false);
+        add(lits, NUMBER_COUNT);
+
+        for (int i = 0; i < NUMBER_COUNT; ++i)
+            for (int j = i + 1; j < NUMBER_COUNT; ++j)
+            {
+                uint32_t pair[2] = { mkLit(vars[i], true), mkLit(vars[j], true) };
+                add(pair, 2);
+            }
+    }
+
+    BaseFormula() : watches(2 * VAR_COUNT)
+    {
+        int vars[NUMBER_COUNT];
+        for (int cell = 0; cell < 81; ++cell)
+        {
+            for (int d = 0; d < NUMBER_COUNT; ++d)
+                vars[d] = cellVar(cell, d);
+            exactlyOne(vars);
+        }
+        for (int u = 0; u < UNIT_COUNT; ++u)
+            for (int d = 0; d < NUMBER_COUNT; ++d)
+            {
+                for (int k = 0; k < NUMBER_COUNT; ++k)
+                    vars[k] = cellVar(UNITS.cells[u][k], d);
+                exactlyOne(vars);
+            }
+    }
+};
+
+const BaseFormula& baseFormula()
+{
+    static const BaseFormula formula;
+    return formula;
+}
+
+constexpr size_t LEARNT_HEADROOM = 1 << 16;   // arena words for learnt clauses
+constexpr size_t WATCH_HEADROOM = 32;          // learnt watchers per literal
+
+// Per-thread solver state, reused between solves so copying the base
+// formula in does not allocate.
+struct Cdcl
+{
+    std::vector<uint32_t> arena;
+    std::vector<std::vector<Watcher>> watches;   // by literal: clauses watching it
+    uint8_t assign[VAR_COUNT];
+    uint8_t phase[VAR_COUNT];
+    uint8_t seen[VAR_COUNT];
+    int level[VAR_COUNT];
+    uint32_t reason[VAR_COUNT];
+    double activity[VAR_COUNT];
+    double activityInc = 1.0;
+
+    std::vector<uint32_t> trail;
+    std::vector<size_t> trailLim;
+    size_t qhead = 0;
+    std::vector<uint32_t> learnt;
+
+    uint8_t value(uint32_t lit) const
+    {
+        uint8_t a = assign[litVar(lit)];
+        return a == L_UNDEF ? (uint8_t)L_UNDEF : (uint8_t)(a ^ (lit & 1));
+    }
+
+    int decisionLevel() const { return (int)trailLim.size(); }
+
+    void watch(uint32_t cref)
+    {
+        const uint32_t* c = &arena[cref + 1];
+        watches[c[0]].push_back({ cref, c[1] });
+        watches[c[1]].push_back({ cref, c[0] });
+    }
+
+    void reset()
+    {
+        const BaseFormula& base = baseFormula();
+        if (arena.capacity() < base.arena.size() + LEARNT_HEADROOM)
+        {
+            // room for the clauses learnt by one solve, reserved once per
+            // thread so a harder puzzle than the last does not reallocate
+            arena.reserve(base.arena.size() + LEARNT_HEADROOM);
+            watches.resize(base.watches.size());
+            for (size_t lit = 0; lit < watches.size(); ++lit)
+                watches[lit].reserve(base.watches[lit].size() + WATCH_HEADROOM);
+            trail.reserve(VAR_COUNT);
+            trailLim.reserve(VAR_COUNT);
+            learnt.reserve(VAR_COUNT);
+        }
+        arena = base.arena;
+        watches = base.watches;
+
+        std::fill(assign, assign + VAR_COUNT, L_UNDEF);
+        std::fill(phase, phase + VAR_COUNT, L_TRUE);   // decide "place digit" first
+        std::fill(seen, seen + VAR_COUNT, 0);
+        std::fill(reason, reason + VAR_COUNT, NO_REASON);
+        std::fill(activity, activity + VAR_COUNT, 0.0);
+        activityInc = 1.0;
+        trail.clear();
+        trailLim.clear();
+        qhead = 0;
+    }
+
+    void enqueue(uint32_t lit, uint32_t from)
+    {
+        int v = litVar(lit);
+        assign[v] = (uint8_t)((lit & 1) ? L_FALSE : L_TRUE);
+        level[v] = decisionLevel();
+        reason[v] = from;
+        trail.push_back(lit);
+    }
+
+    // NO_REASON if no conflict, otherwise the conflicting clause
+    uint32_t propagate()
+    {
+        while (qhead < trail.size())
+        {
+            uint32_t falseLit = trail[qhead++] ^ 1;
+            std::vector<Watcher>& ws = watches[falseLit];
+
+            size_t i = 0, j = 0;
+            while (i < ws.size())
+            {
+                Watcher w = ws[i++];
+                if (value(w.blocker) == L_TRUE)
+                {
+                    ws[j++] = w;
+                    continue;
+                }
+
+                uint32_t* c = &arena[w.cref + 1];
+                uint32_t size = arena[w.cref];
+                if (c[0] == falseLit)
+                    std::swap(c[0], c[1]);
+
+                uint32_t first = c[0];
+                if (first != w.blocker && value(first) == L_TRUE)
+                {
+                    ws[j++] = { w.cref, first };
+                    continue;
+                }
+
+                bool moved = false;
+                for (uint32_t k = 2; k < size; ++k)
+                    if (value(c[k]) != L_FALSE)
+                    {
+                        std::swap(c[1], c[k]);
+                        watches[c[1]].push_back({ w.cref, first });
+                        moved = true;
+                        break;
+                    }
+                if (moved)
+                    continue;
+
+                ws[j++] = { w.cref, first };
+                if (value(first) == L_FALSE)
+                {
+                    while (i < ws.size())
+                        ws[j++] = ws[i++];
+                    ws.resize(j);
+                    return w.cref;
+                }
+                enqueue(first, w.cref);
+            }
+            ws.resize(j);
+        }
+        return NO_REASON;
+    }
+
+    void bump(int v)
+    {
+        if ((activity[v] += activityInc) > 1e100)
+        {
+            for (double& a : activity)
+                a *= 1e-100;
+            activityInc *= 1e-100;
+        }
+    }
+
+    // 1-UIP clause into 'learnt' (asserting literal first); returns the
+    // backjump level
+    int analyze(uint32_t conflict)
+    {
+        learnt.clear();
+        learnt.push_back(NO_LIT);
+
+        int pathCount = 0;
+        uint32_t p = NO_LIT;
+        size_t index = trail.size();
+        uint32_t cref = conflict;
+
+        do
+        {
+            const uint32_t* c = &arena[cref + 1];
+            uint32_t size = arena[cref];
+            for (uint32_t k = (p == NO_LIT ? 0 : 1); k < size; ++k)
+            {
+                int v = litVar(c[k]);
+                if (seen[v] || level[v] == 0)
+                    continue;
+                seen[v] = 1;
+                bump(v);
+                if (level[v] >= decisionLevel())
+                    ++pathCount;
+                else
+                    learnt.push_back(c[k]);
+            }
+
+            while (!seen[litVar(trail[--index])]);
+            p = trail[index];
+            cref = reason[litVar(p)];
+            seen[litVar(p)] = 0;
+            --pathCount;
+        } while (pathCount > 0);
+        learnt[0] = p ^ 1;
+
+        int back = 0;
+        size_t maxAt = 1;
+        for (size_t k = 1; k < learnt.size(); ++k)
+        {
+            int l = level[litVar(learnt[k])];
+            if (l > back)
+            {
+                back = l;
+                maxAt = k;
+            }
+        }
+        if (learnt.size() > 1)
+            std::swap(learnt[1], learnt[maxAt]);   // second watch on the backjump level
+
+        for (uint32_t lit : learnt)
+            seen[litVar(lit)] = 0;
+        activityInc *= 1.0 / 0.95;
+        return back;
+    }
+
+    void backtrack(int toLevel)
+    {
+        if (decisionLevel() <= toLevel)
+            return;
+        for (size_t i = trail.size(); i-- > trailLim[toLevel];)
+        {
+            int v = litVar(trail[i]);
+            phase[v] = assign[v];
+            assign[v] = L_UNDEF;
+            reason[v] = NO_REASON;
+        }
+        trail.resize(trailLim[toLevel]);
+        trailLim.resize(toLevel);
+        qhead = trail.size();
+    }
+
+    int pickBranchVar() const
+    {
+        int best = -1;
+        double bestActivity = -1.0;
+        for (int v = 0; v < VAR_COUNT; ++v)
+            if (assign[v] == L_UNDEF && activity[v] > bestActivity)
+            {
+                best = v;
+                bestActivity = activity[v];
+            }
+        return best;
+    }
+
+    // seed VSIDS with the MRV order: variables of cells with few digits left first
+    void seedActivity()
+    {
+        for (int cell = 0; cell < 81; ++cell)
+        {
+            int open = 0;
+            for (int d = 0; d < NUMBER_COUNT; ++d)
+                open += assign[cellVar(cell, d)] == L_UNDEF;
+            for (int d = 0; d < NUMBER_COUNT; ++d)
+                activity[cellVar(cell, d)] = (double)(NUMBER_COUNT - open) * 1e-3;
+        }
+    }
+};
+
+}
+
+SolveResult CDCLSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult CDCLSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult CDCLSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+{
+    if (sudoku.isSolved())
+        return SolveResult::AlreadySolved;
+
+    thread_local Cdcl s;
+    s.reset();
+
+    const uint8_t* grid = sudoku.rawGrid();
+    for (int cell = 0; cell < 81; ++cell)
+    {
+        if (grid[cell] == UNASSIGNED)
+            continue;
+        uint32_t lit = mkLit(cellVar(cell, grid[cell] - 1), false);
+        if (s.value(lit) == L_FALSE)
+            return SolveResult::Unsolvable;
+        if (s.value(lit) == L_UNDEF)
+            s.enqueue(lit, NO_REASON);
+    }
+    if (s.propagate() != NO_REASON)
+        return SolveResult::Unsolvable;
+    s.seedActivity();
+
+    BudgetGuard guard(budget);
+    uint64_t conflictsToRestart = 100, conflictsSinceRestart = 0;
+
+    while (true)
+    {
+        uint32_t conflict = s.propagate();
+        if (conflict != NO_REASON)
+        {
+            ++search.backtracks;
+            if (s.decisionLevel() == 0)
+                return SolveResult::Unsolvable;
+
+            int back = s.analyze(conflict);
+            s.backtrack(back);
+            if (s.learnt.size() == 1)
+                s.enqueue(s.learnt[0], NO_REASON);
+            else
+            {
+                uint32_t cref = (uint32_t)s.arena.size();
+                s.arena.push_back((uint32_t)s.learnt.size());
+                s.arena.insert(s.arena.end(), s.learnt.begin(), s.learnt.end());
+                s.watch(cref);
+                s.enqueue(s.learnt[0], cref);
+            }
+
+            if (++conflictsSinceRestart >= conflictsToRestart)
+            {
+                s.backtrack(0);
+                conflictsSinceRestart = 0;
+                conflictsToRestart += conflictsToRestart / 2;
+                ++search.restarts;
+            }
+            continue;
+        }
+
+        int v = s.pickBranchVar();
+        if (v < 0)
+            break;   // every variable assigned without conflict: solved
+
+        if (guard.exhausted())
+            return SolveResult::BudgetExceeded;
+
+        ++search.nodes;
+        ++search.guesses;
+        s.trailLim.push_back(s.trail.size());
+        if ((uint32_t)s.decisionLevel() > search.maxDepth)
+            search.maxDepth = (uint32_t)s.decisionLevel();
+        s.enqueue(mkLit(v, s.phase[v] == L_FALSE), NO_REASON);
+    }
+
+    uint8_t* out = sudoku.rawGridMutable();
+    for (int cell = 0; cell < 81; ++cell)
+        for (int d = 0; d < NUMBER_COUNT; ++d)
+            if (s.assign[cellVar(cell, d)] == L_TRUE)
+                out[cell] = (uint8_t)(d + 1);
+    return SolveResult::SolvedByBacktracking;
+}
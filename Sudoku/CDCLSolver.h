@@ -0,0 +1,26 @@
+#pragma once
+#include "ISudokuSolver.h"
+#include "Sudoku.h"
+
+// Conflict-driven clause learning on the standard 729-variable encoding
+// (variable = cell x digit): at-least/at-most-one per cell and per unit
+// digit, givens as level-0 facts. Two-watched-literal propagation, 1-UIP
+// learning with non-chronological backjumping, VSIDS decisions with phase
+// saving and geometric restarts. Self-contained, no external SAT solver.
+//
+// Slower than the logical engines on typical puzzles (encoding and
+// propagation overhead), but it does not repeat a failure it has learned,
+// which bounds the worst case on grids built against chronological search.
+// Meant as an escalation target (--escalate cdcl) or a router engine.
+//
+// SearchStats: nodes = decisions, backtracks = conflicts,
+// maxDepth = deepest decision level.
+class CDCLSolver : public ISudokuSolver
+{
+public:
+    SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    // the budget counts decisions
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
+    const char* getName() const override { return "CDCL Solver"; }
+};
@@ -21,18 +21,24 @@ CUDASolver::~CUDASolver() {}
 void CUDASolver::solve(std::vector<std::vector<Sudoku>>& datasets)
 {
     
-    std::vector<Sudoku*> flat;
-    flat.reserve(120000);
+    size_t total = 0;
+    for (const std::vector<Sudoku>& ds : datasets)
+        total += ds.size();
 
-    for (std::vector<Sudoku>& ds : datasets)
-        for (Sudoku& s : ds)
-            flat.push_back(&s);
-
-    const int count = (int)flat.size();
+    const int count = (int)total;
     if (count == 0) return;
 
-    std::vector<uint8_t> grids(count * 81);
-    std::vector<uint16_t> cands(count * 81);
+    // staging buffers come from the arena: no heap allocation once a call
+    // of this size has been seen
+    staging.reset();
+    Sudoku** flat = staging.allocate<Sudoku*>(total);
+    uint8_t* grids = staging.allocate<uint8_t>(total * 81);
+    uint16_t* cands = staging.allocate<uint16_t>(total * 81);
+
+    size_t n = 0;
+    for (std::vector<Sudoku>& ds : datasets)
+        for (Sudoku& s : ds)
+            flat[n++] = &s;
 
     // === EXTRACT (memcpy) ===
     for (int i = 0; i < count; ++i)
@@ -54,8 +60,8 @@ void CUDASolver::solve(std::vector<std::vector<Sudoku>>& datasets)
     Clock::time_point t0 = Clock::now();
 
     runCudaLogicalBasic(
-        grids.data(),
-        cands.data(),
+        grids,
+        cands,
         count);
 
     Clock::time_point t1 = Clock::now();
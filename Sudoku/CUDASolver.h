@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include "BatchArena.h"
 
 class Sudoku;
 
@@ -11,4 +12,7 @@ public:
 
     // Runs CUDA (Naked + Hidden Single) and writes back to Sudoku objects
     void solve(std::vector<std::vector<Sudoku>>& datasets);
+
+private:
+    BatchArena staging;   // flat pointers + grid / candidate staging
 };
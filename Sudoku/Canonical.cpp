@@ -0,0 +1,245 @@
+#include "Canonical.h"
+
+#include <algorithm>
+#include <array>
+
+using LineOrder = std::array<uint8_t, NUMBER_COUNT>;
+using Triple = std::array<uint8_t, 3>;
+
+// Fixed-capacity lists: canonicalize runs on every CachedSolver lookup and
+// must not allocate.
+struct TripleList
+{
+    Triple v[6];   // 3! orders at most
+    size_t n = 0;
+};
+
+struct LineOrderList
+{
+    LineOrder v[Canonicalizer::MAX_CANDIDATES];
+    size_t n = 0;
+};
+
+/* ============================================================
+   KEY
+   ============================================================ */
+PuzzleKey PuzzleKey::pack(const uint8_t* grid)
+{
+    PuzzleKey k;
+    for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+        k.w[i / 16] |= (uint64_t)(grid[i] & 0xF) << (4 * (i % 16));
+    return k;
+}
+
+void PuzzleKey::unpack(uint8_t* grid) const
+{
+    for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+        grid[i] = (uint8_t)((w[i / 16] >> (4 * (i % 16))) & 0xF);
+}
+
+uint64_t PuzzleKey::hash() const
+{
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 6; ++i)
+    {
+        h ^= w[i];
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+/* ============================================================
+   LINE ORDERS
+   ============================================================ */
+static uint64_t mixKey(uint64_t h, uint64_t v)
+{
+    h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+// insertion sort, lists here have at most 9 entries
+static void sortSmall(uint8_t* v, int n)
+{
+    for (int i = 1; i < n; ++i)
+        for (int j = i; j > 0 && v[j - 1] > v[j]; --j)
+            std::swap(v[j - 1], v[j]);
+}
+
+// all orders of 3 items whose keys match the descending sorted key sequence
+static void tiedPermutations(const uint8_t items[3], const uint64_t* keyOf, TripleList& out)
+{
+    static const uint8_t PERMS[6][3] = {
+        { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+    };
+    out.n = 0;
+    for (const auto& p : PERMS)
+    {
+        Triple o = { items[p[0]], items[p[1]], items[p[2]] };
+        if (keyOf[o[0]] == keyOf[items[0]] && keyOf[o[1]] == keyOf[items[1]] && keyOf[o[2]] == keyOf[items[2]])
+            out.v[out.n++] = o;
+    }
+}
+
+// Orders of 9 lines (rows or columns): groups (bands/stacks) sorted by the
+// sorted keys of their lines, lines sorted by key inside each group, ties
+// enumerated.
+static void lineOrders(const uint64_t key[NUMBER_COUNT], LineOrderList& out, size_t cap)
+{
+    uint8_t inGroup[3][3];
+    uint64_t groupKey[3];
+    for (uint8_t g = 0; g < 3; ++g)
+    {
+        uint8_t l[3] = { (uint8_t)(3 * g), (uint8_t)(3 * g + 1), (uint8_t)(3 * g + 2) };
+        std::sort(l, l + 3, [&](uint8_t a, uint8_t b) { return key[a] > key[b]; });
+        std::copy(l, l + 3, inGroup[g]);
+        groupKey[g] = mixKey(mixKey(mixKey(0, key[l[0]]), key[l[1]]), key[l[2]]);
+    }
+
+    uint8_t groups[3] = { 0, 1, 2 };
+    std::sort(groups, groups + 3, [&](uint8_t a, uint8_t b) { return groupKey[a] > groupKey[b]; });
+
+    TripleList groupPerms;
+    tiedPermutations(groups, groupKey, groupPerms);
+
+    TripleList linePerms[3];
+    for (uint8_t g = 0; g < 3; ++g)
+        tiedPermutations(inGroup[g], key, linePerms[g]);
+
+    out.n = 0;
+    for (size_t gi = 0; gi < groupPerms.n; ++gi)
+    {
+        const Triple& gp = groupPerms.v[gi];
+        const TripleList& la = linePerms[gp[0]];
+        const TripleList& lb = linePerms[gp[1]];
+        const TripleList& lc = linePerms[gp[2]];
+        for (size_t ia = 0; ia < la.n; ++ia)
+            for (size_t ib = 0; ib < lb.n; ++ib)
+                for (size_t ic = 0; ic < lc.n; ++ic)
+                {
+                    if (out.n >= cap)
+                        return;
+                    const Triple& a = la.v[ia];
+                    const Triple& b = lb.v[ib];
+                    const Triple& c = lc.v[ic];
+                    out.v[out.n++] = { a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2] };
+                }
+    }
+}
+
+/* ============================================================
+   CANONICALIZE
+   ============================================================ */
+void Canonicalizer::canonicalize(const Sudoku& sudoku, CanonicalForm& out)
+{
+    const uint8_t* g = sudoku.rawGrid();
+
+    // relabel-invariant counts
+    uint8_t rowCount[9] = {}, colCount[9] = {}, digitFreq[10] = {};
+    for (int r = 0; r < 9; ++r)
+        for (int c = 0; c < 9; ++c)
+            if (uint8_t v = g[POS(r, c)])
+            {
+                ++rowCount[r];
+                ++colCount[c];
+                ++digitFreq[v];
+            }
+
+    // row key: clue count + sorted (column count, digit frequency) of its clues
+    uint64_t rowKey[9], colKey[9];
+    for (int l = 0; l < 9; ++l)
+    {
+        uint8_t rv[9], cv[9];
+        int rn = 0, cn = 0;
+        for (int k = 0; k < 9; ++k)
+        {
+            if (uint8_t v = g[POS(l, k)]) rv[rn++] = (uint8_t)(colCount[k] * 16 + digitFreq[v]);
+            if (uint8_t v = g[POS(k, l)]) cv[cn++] = (uint8_t)(rowCount[k] * 16 + digitFreq[v]);
+        }
+        sortSmall(rv, rn);
+        sortSmall(cv, cn);
+        rowKey[l] = (uint64_t)rn;
+        colKey[l] = (uint64_t)cn;
+        for (int k = 0; k < rn; ++k) rowKey[l] = mixKey(rowKey[l], rv[k]);
+        for (int k = 0; k < cn; ++k) colKey[l] = mixKey(colKey[l], cv[k]);
+    }
+
+    LineOrderList rowOrders, colOrders;   // about 9 KB of stack
+    bool first = true;
+    out.complete = true;
+
+    for (int transposed = 0; transposed < 2; ++transposed)
+    {
+        // in the transposed orientation rows are the original columns
+        const uint64_t* outerKey = transposed ? colKey : rowKey;
+        const uint64_t* innerKey = transposed ? rowKey : colKey;
+
+        lineOrders(outerKey, rowOrders, MAX_CANDIDATES);
+        size_t colCap = std::max<size_t>(1, MAX_CANDIDATES / rowOrders.n);
+        lineOrders(innerKey, colOrders, colCap);
+        if (rowOrders.n >= MAX_CANDIDATES || colOrders.n >= colCap)
+            out.complete = false;
+
+        for (size_t ri = 0; ri < rowOrders.n; ++ri)
+            for (size_t ci = 0; ci < colOrders.n; ++ci)
+            {
+                const LineOrder& ro = rowOrders.v[ri];
+                const LineOrder& co = colOrders.v[ci];
+                uint8_t label[10] = {};
+                uint8_t next = 1;
+                bool better = first;     // already smaller than best
+                bool worse = false;
+                uint8_t grid[81], source[81];
+
+                for (int i = 0; i < 9 && !worse; ++i)
+                    for (int j = 0; j < 9; ++j)
+                    {
+                        uint8_t src = transposed ? (uint8_t)POS(co[j], ro[i]) : (uint8_t)POS(ro[i], co[j]);
+                        uint8_t v = g[src];
+                        if (v && !label[v])
+                            label[v] = next++;
+                        uint8_t cv = label[v];
+
+                        int k = POS(i, j);
+                        if (!better)
+                        {
+                            if (cv > out.grid[k]) { worse = true; break; }
+                            if (cv < out.grid[k]) better = true;
+                        }
+                        grid[k] = cv;
+                        source[k] = src;
+                    }
+
+                if (worse || !better)
+                    continue;
+
+                std::copy(grid, grid + 81, out.grid);
+                std::copy(source, source + 81, out.source);
+                std::copy(label, label + 10, out.label);
+                first = false;
+            }
+    }
+
+    // digits without clues get the remaining labels in order
+    uint8_t used = 0;
+    for (uint8_t d = 1; d <= 9; ++d)
+        if (out.label[d]) ++used;
+    for (uint8_t d = 1; d <= 9; ++d)
+        if (!out.label[d]) out.label[d] = ++used;
+    out.label[0] = 0;
+}
+
+void Canonicalizer::toOriginal(const CanonicalForm& form, const uint8_t* canonical, uint8_t* original)
+{
+    uint8_t inverse[10] = {};
+    for (uint8_t d = 0; d <= 9; ++d)
+        inverse[form.label[d]] = d;
+    for (int i = 0; i < 81; ++i)
+        original[form.source[i]] = inverse[canonical[i]];
+}
+
+void Canonicalizer::toCanonical(const CanonicalForm& form, const uint8_t* original, uint8_t* canonical)
+{
+    for (int i = 0; i < 81; ++i)
+        canonical[i] = form.label[original[form.source[i]]];
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Sudoku.h"
+
+// Packed 81 x 4-bit grid, usable as a hash key.
+struct PuzzleKey
+{
+    uint64_t w[6] = {};
+
+    static PuzzleKey pack(const uint8_t* grid);
+    void unpack(uint8_t* grid) const;
+    uint64_t hash() const;
+
+    bool operator==(const PuzzleKey& o) const
+    {
+        for (int i = 0; i < 6; ++i)
+            if (w[i] != o.w[i]) return false;
+        return true;
+    }
+};
+
+struct PuzzleKeyHash
+{
+    size_t operator()(const PuzzleKey& k) const { return (size_t)k.hash(); }
+};
+
+// A puzzle mapped into its canonical frame: canonical cell i holds
+// label[original[source[i]]].
+struct CanonicalForm
+{
+    uint8_t grid[NUMBER_COUNT * NUMBER_COUNT];    // canonical clues
+    uint8_t source[NUMBER_COUNT * NUMBER_COUNT];  // original cell of canonical cell i
+    uint8_t label[NUMBER_COUNT + 1];              // original digit -> canonical digit
+    bool complete;                                // false if tie enumeration hit the cap
+
+    PuzzleKey key() const { return PuzzleKey::pack(grid); }
+};
+
+// Canonical form under the Sudoku symmetries (transposition, band/stack
+// permutations, row/column permutations inside them, digit relabeling).
+// Bands, rows, stacks and columns are ordered by relabel-invariant keys
+// (clue counts and digit frequencies); only orderings of tied lines are
+// enumerated, and the lexicographically smallest relabeled grid wins.
+// Equivalent puzzles get the same form unless the tie enumeration is
+// capped (highly symmetric puzzles), which only costs cache hits.
+class Canonicalizer
+{
+public:
+    static constexpr size_t MAX_CANDIDATES = 512;  // per orientation
+
+    static void canonicalize(const Sudoku& sudoku, CanonicalForm& out);
+
+    // canonical-frame grid -> original frame (e.g. a cached solution)
+    static void toOriginal(const CanonicalForm& form, const uint8_t* canonical, uint8_t* original);
+    // original-frame grid -> canonical frame
+    static void toCanonical(const CanonicalForm& form, const uint8_t* original, uint8_t* canonical);
+};
@@ -0,0 +1,88 @@
+#include "CommandLine.h"
+#include <sstream>
+#include <stdexcept>
+
+CommandLine::CommandLine(int argc, char** argv)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0)
+        {
+            positionalArgs.push_back(arg);
+            continue;
+        }
+
+        arg = arg.substr(2);
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos)
+            options[arg.substr(0, eq)] = arg.substr(eq + 1);
+        else if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0)
+            options[arg] = argv[++i];
+        else
+            options[arg] = "1";
+    }
+}
+
+bool CommandLine::has(const std::string& name) const
+{
+    return options.count(name) != 0;
+}
+
+std::string CommandLine::get(const std::string& name, const std::string& def) const
+{
+    auto it = options.find(name);
+    return it == options.end() ? def : it->second;
+}
+
+long long CommandLine::getInt(const std::string& name, long long def) const
+{
+    auto it = options.find(name);
+    if (it == options.end())
+        return def;
+    try {
+        return std::stoll(it->second);
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error("Option --" + name + " expects an integer.");
+    }
+}
+
+double CommandLine::getDouble(const std::string& name, double def) const
+{
+    auto it = options.find(name);
+    if (it == options.end())
+        return def;
+    try {
+        return std::stod(it->second);
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error("Option --" + name + " expects a number.");
+    }
+}
+
+std::vector<std::string> CommandLine::getList(const std::string& name, const std::string& def) const
+{
+    std::vector<std::string> out;
+    std::stringstream ss(get(name, def));
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            out.push_back(item);
+    return out;
+}
+
+std::vector<long long> CommandLine::getIntList(const std::string& name, const std::string& def) const
+{
+    std::vector<long long> out;
+    for (const std::string& item : getList(name, def))
+    {
+        try {
+            out.push_back(std::stoll(item));
+        }
+        catch (const std::exception&) {
+            throw std::runtime_error("Option --" + name + " expects a list of integers.");
+        }
+    }
+    return out;
+}
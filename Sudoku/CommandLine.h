@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+
+// Minimal "--name value" / "--name=value" / "--flag" parser for the
+// command modes of the executable (bench, ...).
+class CommandLine
+{
+public:
+    CommandLine(int argc, char** argv);
+
+    bool has(const std::string& name) const;
+    std::string get(const std::string& name, const std::string& def = "") const;
+    long long getInt(const std::string& name, long long def) const;
+    double getDouble(const std::string& name, double def) const;
+
+    // comma separated list: --solvers logical,mrv
+    std::vector<std::string> getList(const std::string& name, const std::string& def = "") const;
+    std::vector<long long> getIntList(const std::string& name, const std::string& def = "") const;
+
+    // arguments that are not options (in order)
+    const std::vector<std::string>& positional() const { return positionalArgs; }
+
+private:
+    std::map<std::string, std::string> options;
+    std::vector<std::string> positionalArgs;
+};
@@ -1,9 +1,11 @@
 ﻿#include "DatasetLoader.h"
+#include "Trace.h"
 
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
@@ -12,17 +14,22 @@ static std::string mergedPath(const std::string& folder)
     return folder + "/merged.txt";
 }
 
+std::string DatasetLoader::datasetFolder(const std::string& rootFolder, int index)
+{
+    return rootFolder + "/Dataset" + std::to_string(index);
+}
+
 std::vector<std::vector<Sudoku>>
 DatasetLoader::loadAllDatasets(const std::string& rootFolder, size_t maxSudokuCountToLoad)
 {
     std::vector<std::vector<Sudoku>> all;
 
-    for (int d = 0; d <= 5; ++d)
+    for (int d = 0; d < DATASET_COUNT; ++d)
     {
-        std::string folder =
-            rootFolder + "/dataset" + std::to_string(d);
+        std::string folder = datasetFolder(rootFolder, d);
 
         std::cout << "[INFO] Loading " << folder << std::endl;
+        TRACE_SCOPE("load dataset", "io", d);
         all.push_back(loadSingleDataset(folder, maxSudokuCountToLoad));
     }
 
@@ -32,6 +39,7 @@ DatasetLoader::loadAllDatasets(const std::string& rootFolder, size_t maxSudokuCo
 std::vector<Sudoku>
 DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSudokuCountToLoad)
 {
+    TRACE_SCOPE("read dataset", "io", -1);
     std::vector<Sudoku> sudokus;
     std::string merged = mergedPath(datasetFolder);
 
@@ -47,7 +55,7 @@ DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSud
         size_t count;
         in >> count;
 
-        sudokus.reserve(count);
+        sudokus.reserve(std::min(count, maxSudokuCountToLoad));
 
         for (size_t i = 0; i < count && i < maxSudokuCountToLoad; ++i)
         {
@@ -87,6 +95,7 @@ DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSud
     }
 
     std::sort(files.begin(), files.end());
+    sudokus.reserve(files.size());   // usually one puzzle per file
 
     // 1️⃣ Önce RAM’e oku
     for (size_t i = 0; i < files.size(); ++i)
@@ -98,6 +107,13 @@ DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSud
         std::ifstream in(files[i]);
         if (!in)
             continue;
+
+        // bir dosyada satır formatında çok sayıda sudoku olabilir
+        if (readLineFormat(in, sudokus))
+            continue;
+        in.clear();
+        in.seekg(0);
+
         try{
             Sudoku s;
             in >> s;                     // <<< operator>>
@@ -113,7 +129,17 @@ DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSud
               << " sudokus from " << files.size() << " files."
 		<< std::endl;
     // 2️⃣ Sonra tek seferde merged.txt yaz
-    std::ofstream out(merged);
+    writeMerged(datasetFolder, sudokus);
+
+    if (sudokus.size() > maxSudokuCountToLoad)
+        sudokus.resize(maxSudokuCountToLoad);
+
+    return sudokus;
+}
+
+void DatasetLoader::writeMerged(const std::string& datasetFolder, const std::vector<Sudoku>& sudokus)
+{
+    std::ofstream out(mergedPath(datasetFolder));
     if (!out)
         throw std::runtime_error("Cannot create merged.txt");
 
@@ -121,6 +147,59 @@ DatasetLoader::loadSingleDataset(const std::string& datasetFolder, size_t maxSud
 
     for (size_t i = 0; i < sudokus.size(); ++i)
         sudokus[i].writeRaw(out);
+}
 
-    return sudokus;
+void DatasetLoader::writeLineFormat(std::ostream& out, const std::vector<Sudoku>& sudokus)
+{
+    out << sudokus.size() << '\n';
+
+    std::string line(NUMBER_COUNT * NUMBER_COUNT, '0');
+    for (const Sudoku& s : sudokus)
+    {
+        const uint8_t* g = s.rawGrid();
+        for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+            line[i] = (char)('0' + g[i]);
+        out << line << '\n';
+    }
+}
+
+bool DatasetLoader::readLineFormat(std::istream& in, std::vector<Sudoku>& out)
+{
+    size_t count;
+    std::string line;
+    if (!(in >> count) || !(in >> line) || line.size() != 81)
+        return false;
+
+    size_t skipped = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0 && !(in >> line))
+            break;
+
+        std::string digits = line;
+        std::replace(digits.begin(), digits.end(), '.', '0');
+
+        std::string spaced;
+        spaced.reserve(162);
+        for (char ch : digits)
+        {
+            spaced += ch;
+            spaced += ' ';
+        }
+
+        try {
+            std::istringstream cell(spaced);
+            Sudoku s;
+            cell >> s;
+            out.push_back(s);
+        }
+        catch (const std::runtime_error&) {
+            ++skipped;
+        }
+    }
+
+    if (skipped)
+        std::cerr << "[WARN] Skipped " << skipped
+            << " invalid line-format sudokus" << std::endl;
+    return true;
 }
\ No newline at end of file
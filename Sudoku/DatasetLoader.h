@@ -6,13 +6,26 @@
 class DatasetLoader
 {
 public:
+    static constexpr int DATASET_COUNT = 6;
+
     // dataset/ kök klasörünü alır
-    // dataset0..dataset4 -> ayrı ayrı yükler
+    // Dataset0..Dataset5 -> ayrı ayrı yükler
     static std::vector<std::vector<Sudoku>>
         loadAllDatasets(const std::string& rootFolder, size_t maxSudokuCountToLoad = UINTMAX_MAX);
 
-private:
+    // rootFolder/DatasetN
+    static std::string datasetFolder(const std::string& rootFolder, int index);
+
     // Tek bir datasetX klasörünü yükler
     static std::vector<Sudoku>
         loadSingleDataset(const std::string& datasetFolder, size_t maxSudokuCountToLoad = UINTMAX_MAX);
+
+    // datasetFolder/merged.txt: "count" + one raw line per puzzle
+    static void writeMerged(const std::string& datasetFolder, const std::vector<Sudoku>& sudokus);
+
+    // "count" + one 81-character line per puzzle ('0' = empty)
+    static void writeLineFormat(std::ostream& out, const std::vector<Sudoku>& sudokus);
+
+    // "count" + one 81-character line per puzzle ('0' or '.' = empty)
+    static bool readLineFormat(std::istream& in, std::vector<Sudoku>& out);
 };
\ No newline at end of file
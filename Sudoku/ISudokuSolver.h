@@ -1,4 +1,6 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include "Sudoku.h"
 class Sudoku;
@@ -9,6 +11,88 @@ enum class SolveResult
     SolvedByBacktracking,      // Tam zld - backtracking
 	SolvedByLogical,    // Tam zld - mantksal yntemler
     Unsolvable,  // zm yok
+    BudgetExceeded,  // node / time budget ran out (see SolveBudget)
+};
+
+inline const char* solveResultName(SolveResult r)
+{
+    switch (r)
+    {
+    case SolveResult::AlreadySolved: return "AlreadySolved";
+    case SolveResult::SolvedByBacktracking: return "SolvedByBacktracking";
+    case SolveResult::SolvedByLogical: return "SolvedByLogical";
+    case SolveResult::BudgetExceeded: return "BudgetExceeded";
+    default: return "Unsolvable";
+    }
+}
+
+// Search tree counters of the backtracking engines (cheap enough to stay on)
+struct SearchStats {
+    uint64_t nodes = 0;       // search calls
+    uint64_t guesses = 0;     // values placed by the search
+    uint64_t backtracks = 0;  // placements undone
+    uint64_t restarts = 0;    // randomized restarts (MRVOptions::restartUnit)
+    uint32_t maxDepth = 0;
+
+    void merge(const SearchStats& o) {
+        nodes += o.nodes;
+        guesses += o.guesses;
+        backtracks += o.backtracks;
+        restarts += o.restarts;
+        if (o.maxDepth > maxDepth) maxDepth = o.maxDepth;
+    }
+};
+
+// Per-solve limits for the search engines. Zero / default = unlimited.
+struct SolveBudget {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t maxNodes = 0;
+    Clock::time_point deadline{};
+
+    bool unlimited() const { return !maxNodes && deadline == Clock::time_point{}; }
+
+    // budget starting now
+    static SolveBudget of(uint64_t maxNodes, std::chrono::microseconds timeLimit)
+    {
+        SolveBudget b;
+        b.maxNodes = maxNodes;
+        if (timeLimit.count() > 0)
+            b.deadline = Clock::now() + timeLimit;
+        return b;
+    }
+};
+
+// Runtime side of a SolveBudget, polled once per search node. The clock
+// is only read every CLOCK_STRIDE nodes (an MRV node costs ~1-2us, so the
+// deadline overshoots by at most ~0.1ms).
+class BudgetGuard {
+public:
+    static constexpr uint64_t CLOCK_STRIDE = 64;
+
+    explicit BudgetGuard(const SolveBudget& b)
+        : nodeLimit(b.maxNodes ? b.maxNodes : UINT64_MAX),
+          deadline(b.deadline),
+          timed(b.deadline != SolveBudget::Clock::time_point{}) {}
+
+    bool exhausted()
+    {
+        if (hit)
+            return true;
+        if (++nodes > nodeLimit ||
+            (timed && (nodes % CLOCK_STRIDE) == 0 && SolveBudget::Clock::now() >= deadline))
+            hit = true;
+        return hit;
+    }
+
+    bool exceeded() const { return hit; }
+
+private:
+    uint64_t nodes = 0;
+    uint64_t nodeLimit;
+    SolveBudget::Clock::time_point deadline;
+    bool timed;
+    bool hit = false;
 };
 
 struct SolveStats {
@@ -16,9 +100,26 @@ struct SolveStats {
     size_t logical = 0;
     size_t backtracking = 0;
     size_t unsolvable = 0;
+    size_t budgetExceeded = 0;
+    SearchStats search;
     size_t total() const {
-        return alreadySolved + logical + backtracking + unsolvable;
+        return alreadySolved + logical + backtracking + unsolvable + budgetExceeded;
 	}
+    void record(SolveResult r) {
+        if (r == SolveResult::AlreadySolved) ++alreadySolved;
+        else if (r == SolveResult::SolvedByLogical) ++logical;
+        else if (r == SolveResult::SolvedByBacktracking) ++backtracking;
+        else if (r == SolveResult::BudgetExceeded) ++budgetExceeded;
+        else ++unsolvable;
+    }
+    void merge(const SolveStats& o) {
+        alreadySolved += o.alreadySolved;
+        logical += o.logical;
+        backtracking += o.backtracking;
+        unsolvable += o.unsolvable;
+        budgetExceeded += o.budgetExceeded;
+        search.merge(o.search);
+    }
 };
 
 class ISudokuSolver
@@ -29,18 +130,28 @@ public:
     // Tek bir Sudoku z
     virtual SolveResult solve(Sudoku& sudoku) = 0;
 
+    // solve() + search tree counters added to 'search'.
+    // Engines without a search leave it untouched.
+    virtual SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search)
+    {
+        (void)search;
+        return solve(sudoku);
+    }
+
+    // solveWithStats() that gives up with BudgetExceeded once the budget
+    // runs out. Engines without a search ignore the budget.
+    virtual SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+    {
+        (void)budget;
+        return solveWithStats(sudoku, search);
+    }
+
     // oklu Sudoku zm (batch / CUDA / MT yolu)
     virtual SolveStats solveAll(std::vector<Sudoku>& sudokus)
     {
         SolveStats stats;
         for (auto& s : sudokus)
-        {
-            SolveResult r = solve(s);
-			if (r == SolveResult::AlreadySolved) ++stats.alreadySolved;
-            else if (r == SolveResult::SolvedByLogical) ++stats.logical;
-            else if (r == SolveResult::SolvedByBacktracking) ++stats.backtracking;
-            else ++stats.unsolvable;
-        }
+            stats.record(solveWithStats(s, stats.search));
         return stats;
     }
     virtual const char* getName() const = 0;
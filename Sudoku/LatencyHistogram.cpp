@@ -0,0 +1,176 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iomanip>
+
+/* ============================================================
+   HISTOGRAM
+   ============================================================ */
+int LatencyHistogram::bucketOf(uint64_t v)
+{
+    if (v < (uint64_t)SUB_COUNT)
+        return (int)v;
+
+    int e = std::bit_width(v) - 1;                  // >= SUB_BITS
+    int sub = (int)((v >> (e - SUB_BITS)) & (SUB_COUNT - 1));
+    return (e - SUB_BITS + 1) * SUB_COUNT + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpper(int b)
+{
+    if (b < SUB_COUNT)
+        return (uint64_t)b;
+
+    int e = b / SUB_COUNT + SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(b % SUB_COUNT);
+    uint64_t width = 1ull << (e - SUB_BITS);
+    return (1ull << e) + sub * width + (width - 1);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (int b = 0; b < BUCKET_COUNT; ++b)
+        counts[b] += other.counts[b];
+    total += other.total;
+    sum += other.sum;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const
+{
+    if (!total)
+        return 0;
+
+    // rank of the p-th value, 1-based
+    uint64_t rank = (uint64_t)((p / 100.0) * (double)total + 0.5);
+    rank = std::clamp<uint64_t>(rank, 1, total);
+
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; ++b)
+    {
+        seen += counts[b];
+        if (seen >= rank)
+            return std::min(bucketUpper(b), maxValue);
+    }
+    return maxValue;
+}
+
+/* ============================================================
+   REPORT
+   ============================================================ */
+static bool fasterThan(const SlowPuzzle& a, const SlowPuzzle& b)
+{
+    return a.ns > b.ns; // min-heap comparator
+}
+
+void LatencyReport::keepIfSlow(const SlowPuzzle& p)
+{
+    if (!slowestCount)
+        return;
+    if (slow.size() == slowestCount && p.ns <= slow.front().ns)
+        return;
+
+    // same puzzle timed again (repetitions): keep its worst time only
+    for (SlowPuzzle& q : slow)
+        if (q.index == p.index)
+        {
+            if (p.ns > q.ns)
+            {
+                q = p;
+                std::make_heap(slow.begin(), slow.end(), fasterThan);
+            }
+            return;
+        }
+
+    if (slow.size() < slowestCount)
+    {
+        slow.push_back(p);
+        std::push_heap(slow.begin(), slow.end(), fasterThan);
+    }
+    else
+    {
+        std::pop_heap(slow.begin(), slow.end(), fasterThan);
+        slow.back() = p;
+        std::push_heap(slow.begin(), slow.end(), fasterThan);
+    }
+}
+
+void LatencyReport::record(size_t index, SolveResult r, uint64_t ns)
+{
+    all.record(ns);
+    perResult[(size_t)r].record(ns);
+    keepIfSlow({ ns, index, r });
+}
+
+void LatencyReport::merge(const LatencyReport& other)
+{
+    all.merge(other.all);
+    for (size_t i = 0; i < RESULT_COUNT; ++i)
+        perResult[i].merge(other.perResult[i]);
+    for (const SlowPuzzle& p : other.slow)
+        keepIfSlow(p);
+}
+
+std::vector<SlowPuzzle> LatencyReport::slowest() const
+{
+    std::vector<SlowPuzzle> out = slow;
+    std::sort(out.begin(), out.end(), fasterThan);
+    return out;
+}
+
+static void printLine(std::ostream& os, const char* label, const LatencyHistogram& h)
+{
+    os << "  " << std::left << std::setw(22) << label << std::right
+        << " n=" << std::setw(7) << h.count()
+        << " p50=" << std::setw(9) << h.percentile(50) / 1000.0
+        << " p90=" << std::setw(9) << h.percentile(90) / 1000.0
+        << " p99=" << std::setw(9) << h.percentile(99) / 1000.0
+        << " p99.9=" << std::setw(9) << h.percentile(99.9) / 1000.0
+        << " max=" << std::setw(9) << h.max() / 1000.0 << " us\n";
+}
+
+void LatencyReport::print(std::ostream& os, const char* title) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+
+    os << "[" << title << " latency]\n";
+    printLine(os, "all", all);
+    for (size_t i = 0; i < RESULT_COUNT; ++i)
+        if (perResult[i].count())
+            printLine(os, solveResultName((SolveResult)i), perResult[i]);
+
+    std::vector<SlowPuzzle> top = slowest();
+    if (!top.empty())
+    {
+        os << "  slowest:";
+        for (const SlowPuzzle& p : top)
+            os << " #" << p.index << "(" << p.ns / 1000.0 << "us)";
+        os << "\n";
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+SolveStats LatencyReport::solveAll(ISudokuSolver& solver, std::vector<Sudoku>& sudokus,
+    LatencyReport& report)
+{
+    using Clock = std::chrono::steady_clock;
+
+    SolveStats stats;
+    for (size_t i = 0; i < sudokus.size(); ++i)
+    {
+        Clock::time_point t0 = Clock::now();
+        SolveResult r = solver.solveWithStats(sudokus[i], stats.search);
+        Clock::time_point t1 = Clock::now();
+
+        report.record(i, r, (uint64_t)std::chrono::duration_cast<
+            std::chrono::nanoseconds>(t1 - t0).count());
+        stats.record(r);
+    }
+    return stats;
+}
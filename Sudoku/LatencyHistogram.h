@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "ISudokuSolver.h"
+
+// Log-linear latency histogram (HdrHistogram layout): values below
+// 2^SUB_BITS are exact, every power of two above that is split into
+// 2^SUB_BITS linear buckets, so a percentile is off by at most 1/32.
+// Fixed size, no allocation on record.
+class LatencyHistogram
+{
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+    void record(uint64_t ns)
+    {
+        ++counts[bucketOf(ns)];
+        ++total;
+        sum += ns;
+        if (ns > maxValue) maxValue = ns;
+    }
+
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? (double)sum / (double)total : 0.0; }
+
+    // p in [0,100]; upper bound of the bucket holding the p-th value
+    uint64_t percentile(double p) const;
+
+private:
+    static int bucketOf(uint64_t v);
+    static uint64_t bucketUpper(int b);
+
+    uint64_t counts[BUCKET_COUNT] = {};
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t maxValue = 0;
+};
+
+struct SlowPuzzle
+{
+    uint64_t ns;
+    size_t index;       // position in the solved vector
+    SolveResult result;
+};
+
+// Per-puzzle latencies of one dataset: overall + per SolveResult
+// histograms and the slowest N puzzles. Each thread fills its own
+// report; reports are merged after the threads are joined.
+class LatencyReport
+{
+public:
+    static constexpr size_t RESULT_COUNT = 5;
+
+    explicit LatencyReport(size_t slowestCount = 10) : slowestCount(slowestCount) {}
+
+    size_t capacity() const { return slowestCount; }
+
+    void record(size_t index, SolveResult r, uint64_t ns);
+    void merge(const LatencyReport& other);
+
+    const LatencyHistogram& overall() const { return all; }
+    const LatencyHistogram& byResult(SolveResult r) const { return perResult[(size_t)r]; }
+
+    // slowest first
+    std::vector<SlowPuzzle> slowest() const;
+
+    void print(std::ostream& os, const char* title) const;
+
+    // sequential solveAll that times every puzzle
+    static SolveStats solveAll(ISudokuSolver& solver, std::vector<Sudoku>& sudokus,
+        LatencyReport& report);
+
+private:
+    void keepIfSlow(const SlowPuzzle& p);
+
+    LatencyHistogram all;
+    LatencyHistogram perResult[RESULT_COUNT];
+    std::vector<SlowPuzzle> slow;   // min-heap on ns, at most slowestCount
+    size_t slowestCount;
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include "BacktrackingSolverMRV.h"
+#include "LogicalSolverSIMD.h"
+
+// Statically composed logical solver: LogicalPipeline<Steps...> tries the
+// steps in order and restarts from the first one after any progress, like
+// LogicalSolver::applyLogicalStep, but the chain is a fold expression over
+// the policy list. Every step is a direct, qualified call into the technique
+// implementation - no virtual dispatch, no runtime option checks - so the
+// compiler sees the whole chain (and can inline the techniques with whole
+// program optimization).
+//
+// A step policy is any type with
+//     static constexpr int ID;                                  // LS_* slot for stats/profile
+//     static bool apply(LogicalSolverSIMD& engine, Sudoku& s);  // true = progress
+//
+//     using SinglesOnly = LogicalPipeline<NakedSingleSIMD, HiddenSingle>;
+//
+// When the steps stall the pipeline falls back to MRV search, as
+// LogicalSolver does. Options only affect steps that read them
+// (lookahead depth/budget for TrialPropagation); uniqueness techniques run
+// whenever they are listed.
+
+// Qualified (non-virtual) access to the protected technique implementations.
+struct LogicalStepAccess
+{
+    static bool nakedSingle(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolver::applyNakedSingle(s); }
+    static bool nakedSingleSIMD(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolverSIMD::applyNakedSingle(s); }
+    static bool hiddenSingle(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolver::applyHiddenSingle(s); }
+    static bool pointing(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolver::applyLockedCandidatesPointing(s); }
+    static bool pointingSIMD(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolverSIMD::applyLockedCandidatesPointing(s); }
+    static bool claiming(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolver::applyLockedCandidatesClaiming(s); }
+    static bool claimingSIMD(LogicalSolverSIMD& e, Sudoku& s) { return e.LogicalSolverSIMD::applyLockedCandidatesClaiming(s); }
+    static bool nakedSubset(LogicalSolverSIMD& e, Sudoku& s, int n) { return e.LogicalSolver::applyNakedSubset(s, n); }
+    static bool nakedSubsetSIMD(LogicalSolverSIMD& e, Sudoku& s, int n) { return e.LogicalSolverSIMD::applyNakedSubset(s, n); }
+    static bool hiddenSubset(LogicalSolverSIMD& e, Sudoku& s, int n) { return e.LogicalSolver::applyHiddenSubset(s, n); }
+    static bool hiddenSubsetSIMD(LogicalSolverSIMD& e, Sudoku& s, int n) { return e.LogicalSolverSIMD::applyHiddenSubset(s, n); }
+    static bool uniqueRectangle(LogicalSolverSIMD& e, Sudoku& s) { return e.applyUniqueRectangle(s); }
+    static bool bugPlusOne(LogicalSolverSIMD& e, Sudoku& s) { return e.applyBugPlusOne(s); }
+    static bool trialPropagation(LogicalSolverSIMD& e, Sudoku& s) { return e.applyTrialPropagation(s); }
+};
+
+/* ============================================================
+   STEP POLICIES
+   ============================================================ */
+struct NakedSingle
+{
+    static constexpr int ID = LS_NAKED_SINGLE;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::nakedSingle(e, s); }
+};
+
+struct NakedSingleSIMD
+{
+    static constexpr int ID = LS_NAKED_SINGLE;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::nakedSingleSIMD(e, s); }
+};
+
+struct HiddenSingle
+{
+    static constexpr int ID = LS_HIDDEN_SINGLE;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::hiddenSingle(e, s); }
+};
+
+struct Pointing
+{
+    static constexpr int ID = LS_LOCKED_POINTING;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::pointing(e, s); }
+};
+
+struct PointingSIMD
+{
+    static constexpr int ID = LS_LOCKED_POINTING;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::pointingSIMD(e, s); }
+};
+
+struct Claiming
+{
+    static constexpr int ID = LS_LOCKED_CLAIMING;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::claiming(e, s); }
+};
+
+struct ClaimingSIMD
+{
+    static constexpr int ID = LS_LOCKED_CLAIMING;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::claimingSIMD(e, s); }
+};
+
+// N = 2..4 (pair, triple, quad)
+template<int N>
+struct NakedSubset
+{
+    static_assert(N >= 2 && N <= 4, "subset size 2..4");
+    static constexpr int ID = LS_NAKED_PAIR + 2 * (N - 2);
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::nakedSubset(e, s, N); }
+};
+
+template<int N>
+struct NakedSubsetSIMD
+{
+    static_assert(N >= 2 && N <= 4, "subset size 2..4");
+    static constexpr int ID = LS_NAKED_PAIR + 2 * (N - 2);
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::nakedSubsetSIMD(e, s, N); }
+};
+
+template<int N>
+struct HiddenSubset
+{
+    static_assert(N >= 2 && N <= 4, "subset size 2..4");
+    static constexpr int ID = LS_HIDDEN_PAIR + 2 * (N - 2);
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::hiddenSubset(e, s, N); }
+};
+
+template<int N>
+struct HiddenSubsetSIMD
+{
+    static_assert(N >= 2 && N <= 4, "subset size 2..4");
+    static constexpr int ID = LS_HIDDEN_PAIR + 2 * (N - 2);
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::hiddenSubsetSIMD(e, s, N); }
+};
+
+// requires a unique solution (see LogicalOptions::assumeUnique)
+struct UniqueRectangle
+{
+    static constexpr int ID = LS_UNIQUE_RECTANGLE;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::uniqueRectangle(e, s); }
+};
+
+struct BugPlusOne
+{
+    static constexpr int ID = LS_BUG_PLUS_ONE;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::bugPlusOne(e, s); }
+};
+
+struct TrialPropagation
+{
+    static constexpr int ID = LS_TRIAL_PROPAGATION;
+    static bool apply(LogicalSolverSIMD& e, Sudoku& s) { return LogicalStepAccess::trialPropagation(e, s); }
+};
+
+/* ============================================================
+   PIPELINE
+   ============================================================ */
+template<class... Steps>
+class LogicalPipeline : public LogicalSolverSIMD
+{
+    static_assert(sizeof...(Steps) > 0, "LogicalPipeline needs at least one step");
+
+public:
+    using LogicalSolverSIMD::LogicalSolverSIMD;
+    const char* getName() const override { return "Logical Pipeline"; }
+
+    static constexpr size_t stepCount() { return sizeof...(Steps); }
+
+    // one pass: first step that makes progress wins
+    bool applyPipelineStep(Sudoku& s)
+    {
+        return (... || LS_STEP(Steps::ID, Steps::apply(*this, s)));
+    }
+
+    // Steps until solved or stalled on the candidates already in 'sudoku'
+    // (no recompute), so a caller can hand over state from an earlier pass.
+    bool run(Sudoku& sudoku)
+    {
+        while (!sudoku.isSolved() && applyPipelineStep(sudoku));
+        return sudoku.isSolved();
+    }
+
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override
+    {
+        if (sudoku.isSolved())
+            return SolveResult::AlreadySolved;
+
+        sudoku.recomputeCandidates();
+        if (run(sudoku))
+            return SolveResult::SolvedByLogical;
+
+        return BacktrackingSolverMRV().solveWithBudget(sudoku, search, budget);
+    }
+};
+
+// singles only: cheapest pass for easy workloads (Dataset0-2), search does the rest
+using SinglesPipeline = LogicalPipeline<NakedSingleSIMD, HiddenSingle>;
+
+// the logical-simd technique order without the uniqueness steps
+using StandardPipeline = LogicalPipeline<
+    NakedSingleSIMD, HiddenSingle, PointingSIMD, ClaimingSIMD,
+    NakedSubsetSIMD<2>, HiddenSubsetSIMD<2>, NakedSubsetSIMD<3>, HiddenSubsetSIMD<3>,
+    NakedSubsetSIMD<4>, HiddenSubsetSIMD<4>, TrialPropagation>;
+
+// singles and locked candidates; no subsets or lookahead
+using LockedPipeline = LogicalPipeline<NakedSingleSIMD, HiddenSingle, PointingSIMD, ClaimingSIMD>;
@@ -2,6 +2,18 @@
 #include "BacktrackingSolverMRV.h"
 
 SolveResult LogicalSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult LogicalSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+// the logical phase is polynomial; only the MRV fallback is budgeted
+SolveResult LogicalSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
 {
     if (sudoku.isSolved())
         return SolveResult::AlreadySolved;
@@ -12,20 +24,42 @@ SolveResult LogicalSolver::solve(Sudoku& sudoku)
 
     if (sudoku.isSolved()) return SolveResult::SolvedByLogical;
 
-    return BacktrackingSolverMRV().solve(sudoku);
+    return BacktrackingSolverMRV().solveWithBudget(sudoku, search, budget);
+}
+
+const char* LogicalSolver::techniqueName(int id)
+{
+    static const char* const NAMES[LS_COUNT] = {
+        "NakedSingle", "HiddenSingle", "LockedPointing", "LockedClaiming",
+        "NakedPair", "HiddenPair", "NakedTriple", "HiddenTriple",
+        "NakedQuad", "HiddenQuad", "UniqueRectangle", "BugPlusOne",
+        "TrialPropagation"
+    };
+    return id >= 0 && id < LS_COUNT ? NAMES[id] : "?";
 }
 
 bool LogicalSolver::applyLogicalStep(Sudoku& s)
 {
-    if (applyNakedSingle(s))  return true;
-    if (applyHiddenSingle(s)) return true;
+    if (LS_STEP(LS_NAKED_SINGLE, applyNakedSingle(s)))  return true;
+    if (LS_STEP(LS_HIDDEN_SINGLE, applyHiddenSingle(s))) return true;
+
+    if (LS_STEP(LS_LOCKED_POINTING, applyLockedCandidatesPointing(s))) return true;
+    if (LS_STEP(LS_LOCKED_CLAIMING, applyLockedCandidatesClaiming(s))) return true;
+    if (LS_STEP(LS_NAKED_PAIR, applyNakedSubset(s, 2)))     return true;
+    if (LS_STEP(LS_HIDDEN_PAIR, applyHiddenSubset(s, 2)))   return true;
+    if (LS_STEP(LS_NAKED_TRIPLE, applyNakedSubset(s, 3)))   return true;
+    if (LS_STEP(LS_HIDDEN_TRIPLE, applyHiddenSubset(s, 3))) return true;
+    if (LS_STEP(LS_NAKED_QUAD, applyNakedSubset(s, 4)))     return true;
+    if (LS_STEP(LS_HIDDEN_QUAD, applyHiddenSubset(s, 4)))   return true;
+
+    // uniqueness-based techniques (opt-in, see LogicalOptions)
+    if (options.assumeUnique)
+    {
+        if (LS_STEP(LS_UNIQUE_RECTANGLE, applyUniqueRectangle(s))) return true;
+        if (LS_STEP(LS_BUG_PLUS_ONE, applyBugPlusOne(s)))          return true;
+    }
 
-    if (applyLockedCandidatesPointing(s))  return true;
-    if (applyLockedCandidatesClaiming(s))  return true;
-    if (applyNakedPair(s))                 return true;
-    if (applyHiddenPair(s))                return true;
-	if (applyNakedTriple(s))               return true;
-	if (applyHiddenTriple(s))              return true;
+    if (LS_STEP(LS_TRIAL_PROPAGATION, applyTrialPropagation(s)))   return true;
 
     return false;
 }
@@ -172,7 +206,8 @@ bool LogicalSolver::applyLockedCandidatesPointing(Sudoku& sudoku)
                         }
                     }
 
-                if (count <= 1) continue;
+                // a single position is a hidden single, its line is locked too
+                if (count == 0) continue;
 
                 if (lockedRow != 255)
                     for (uint8_t c = 0; c < 9; ++c)
@@ -221,7 +256,7 @@ bool LogicalSolver::applyLockedCandidatesClaiming(Sudoku& sudoku)
                     ++count;
                 }
 
-            if (count <= 1 || lockedBoxRow == 255) continue;
+            if (count == 0 || lockedBoxRow == 255) continue;
 
             for (uint8_t dr = 0; dr < 3; ++dr)
                 for (uint8_t dc = 0; dc < 3; ++dc)
@@ -236,6 +271,39 @@ bool LogicalSolver::applyLockedCandidatesClaiming(Sudoku& sudoku)
                 }
         }
 
+    for (uint8_t col = 0; col < 9; ++col)
+        for (uint8_t digit = 1; digit <= 9; ++digit)
+        {
+            int count = 0;
+            uint8_t lockedBoxRow = 0, lockedBoxCol = 0;
+
+            for (uint8_t row = 0; row < 9; ++row)
+                if (sudoku.get(row, col) == UNASSIGNED &&
+                    sudoku.hasCandidate(row, col, digit))
+                {
+                    uint8_t br = (row / 3) * 3;
+                    uint8_t bc = (col / 3) * 3;
+                    if (count == 0) { lockedBoxRow = br; lockedBoxCol = bc; }
+                    else if (br != lockedBoxRow || bc != lockedBoxCol)
+                        lockedBoxRow = 255;
+                    ++count;
+                }
+
+            if (count == 0 || lockedBoxRow == 255) continue;
+
+            for (uint8_t dr = 0; dr < 3; ++dr)
+                for (uint8_t dc = 0; dc < 3; ++dc)
+                {
+                    uint8_t r = lockedBoxRow + dr;
+                    uint8_t c = lockedBoxCol + dc;
+                    if (c != col &&
+                        sudoku.removeCandidate(r, c, digit))
+                    {
+                        progressed = true; ++localRemove;
+                    }
+                }
+        }
+
     if (progressed) {
         logicalStats.data[LS_LOCKED_CLAIMING][0]++;
         logicalStats.data[LS_LOCKED_CLAIMING][1] += localRemove;
@@ -243,228 +311,553 @@ bool LogicalSolver::applyLockedCandidatesClaiming(Sudoku& sudoku)
     return progressed;
 }
 
-bool LogicalSolver::applyNakedPair(Sudoku& s)
+// k-subsets of unit positions 0..8, sorted by bitmask value (colex order):
+// the first C(n,k) entries only use positions < n, so enumerating over n
+// compacted cells/digits is a prefix scan of the table.
+struct CombinationTable
+{
+    uint8_t idx[126][4];
+    uint8_t prefix[10]; // prefix[n] = C(n, k)
+};
+
+static constexpr CombinationTable makeCombinationTable(int k)
+{
+    CombinationTable t{};
+    int count = 0;
+    for (int n = 0; n <= 9; ++n)
+    {
+        for (int mask = (n ? 1 << (n - 1) : 0); mask < (1 << n); ++mask)
+        {
+            if (std::popcount((unsigned)mask) != k) continue;
+            int p = 0;
+            for (int i = 0; i < 9; ++i)
+                if (mask & (1 << i)) t.idx[count][p++] = (uint8_t)i;
+            ++count;
+        }
+        t.prefix[n] = (uint8_t)count;
+    }
+    return t;
+}
+
+static constexpr CombinationTable COMBINATIONS[5] = {
+    {}, {}, makeCombinationTable(2), makeCombinationTable(3), makeCombinationTable(4)
+};
+
+static constexpr int NAKED_SUBSET_ID[5] = { -1, -1, LS_NAKED_PAIR, LS_NAKED_TRIPLE, LS_NAKED_QUAD };
+static constexpr int HIDDEN_SUBSET_ID[5] = { -1, -1, LS_HIDDEN_PAIR, LS_HIDDEN_TRIPLE, LS_HIDDEN_QUAD };
+
+bool LogicalSolver::applyNakedSubset(Sudoku& s, int size)
 {
     bool changed = false;
     uint32_t localRemove = 0;
 
-    auto isPair = [](uint16_t m) { return std::popcount(m) == 2; };
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+    const CombinationTable& comb = COMBINATIONS[size];
 
-    for (uint8_t r = 0; r < 9; ++r)
-        for (uint8_t c1 = 0; c1 < 8; ++c1)
+    for (int u = 0; u < UNIT_COUNT; ++u)
+    {
+        const uint8_t* cells = UNITS.cells[u];
+
+        // only unsolved cells with 2..size candidates can be members
+        // (single candidates are left to the naked single step)
+        uint8_t members[9];
+        int memberCount = 0, unsolved = 0;
+        for (int k = 0; k < 9; ++k)
         {
-            if (s.get(r, c1) != UNASSIGNED) continue;
-            uint16_t m = s.getCandidates(r, c1);
-            if (!isPair(m)) continue;
+            int i = cells[k];
+            if (grid[i] != UNASSIGNED) continue;
+            ++unsolved;
+            int count = std::popcount(cand[i]);
+            if (count >= 2 && count <= size) members[memberCount++] = (uint8_t)i;
+        }
+        if (memberCount < size || unsolved <= size) continue;
 
-            for (uint8_t c2 = c1 + 1; c2 < 9; ++c2)
+        for (int t = 0; t < comb.prefix[memberCount]; ++t)
+        {
+            const uint8_t* pick = comb.idx[t];
+            uint16_t uni = 0;
+            for (int j = 0; j < size; ++j) uni |= cand[members[pick[j]]];
+            if (std::popcount(uni) != size) continue;
+
+            // an earlier subset of this unit may have shrunk a member to a single
+            bool stillMembers = true;
+            for (int j = 0; j < size; ++j)
+                if (std::popcount(cand[members[pick[j]]]) < 2) stillMembers = false;
+            if (!stillMembers) continue;
+
+            for (int k = 0; k < 9; ++k)
             {
-                if (s.get(r, c2) != UNASSIGNED) continue;
-                if (s.getCandidates(r, c2) != m) continue;
+                int i = cells[k];
+                if (grid[i] != UNASSIGNED) continue;
 
-                for (uint8_t c = 0; c < 9; ++c)
-                    if (c != c1 && c != c2 &&
-                        s.removeCandidatesMask(r, c, m))
-                    {
-                        changed = true; ++localRemove;
-                    }
+                bool inSubset = false;
+                for (int j = 0; j < size; ++j)
+                    if (members[pick[j]] == i) inSubset = true;
+                if (inSubset) continue;
+
+                if (s.removeCandidatesMask(i / 9, i % 9, uni))
+                {
+                    changed = true;
+                    ++localRemove;
+                }
             }
         }
+    }
 
-    if (changed) {
-        logicalStats.data[LS_NAKED_PAIR][0]++;
-        logicalStats.data[LS_NAKED_PAIR][1] += localRemove;
+    if (changed)
+    {
+        logicalStats.data[NAKED_SUBSET_ID[size]][0]++;
+        logicalStats.data[NAKED_SUBSET_ID[size]][1] += localRemove;
     }
+
     return changed;
 }
 
-bool LogicalSolver::applyHiddenPair(Sudoku& s)
+bool LogicalSolver::applyHiddenSubset(Sudoku& s, int size)
 {
     bool changed = false;
     uint32_t localRemove = 0;
 
-    for (uint8_t r = 0; r < 9; ++r)
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+    const CombinationTable& comb = COMBINATIONS[size];
+
+    for (int u = 0; u < UNIT_COUNT; ++u)
     {
+        const uint8_t* cells = UNITS.cells[u];
+
+        // pos[d] = unit positions that still hold digit d
         uint16_t pos[10] = {};
+        int unsolved = 0;
+        for (int k = 0; k < 9; ++k)
+        {
+            int i = cells[k];
+            if (grid[i] != UNASSIGNED) continue;
+            ++unsolved;
+            for (uint16_t m = cand[i]; m; m &= m - 1)
+                pos[std::countr_zero(m) + 1] |= (uint16_t)(1u << k);
+        }
+        if (unsolved <= size) continue;
 
-        for (uint8_t c = 0; c < 9; ++c)
-            if (s.get(r, c) == UNASSIGNED)
+        // only digits with 2..size positions can be members
+        // (single positions are left to the hidden single step)
+        uint8_t members[9];
+        int memberCount = 0;
+        for (uint8_t d = 1; d <= 9; ++d)
+        {
+            int count = std::popcount(pos[d]);
+            if (count >= 2 && count <= size) members[memberCount++] = d;
+        }
+        if (memberCount < size) continue;
+
+        for (int t = 0; t < comb.prefix[memberCount]; ++t)
+        {
+            const uint8_t* pick = comb.idx[t];
+            uint16_t where = 0, keep = 0;
+            for (int j = 0; j < size; ++j)
             {
-                uint16_t m = s.getCandidates(r, c);
-                for (uint8_t d = 1; d <= 9; ++d)
-                    if (m & bit(d)) pos[d] |= (1u << c);
+                where |= pos[members[pick[j]]];
+                keep |= bit(members[pick[j]]);
             }
+            if (std::popcount(where) != size) continue;
 
-        for (uint8_t a = 1; a <= 8; ++a)
-            for (uint8_t b = a + 1; b <= 9; ++b)
-                if (pos[a] == pos[b] && std::popcount(pos[a]) == 2)
+            for (uint16_t w = where; w; w &= w - 1)
+            {
+                int i = cells[std::countr_zero(w)];
+                if (s.removeCandidatesMask(i / 9, i % 9, (uint16_t)~keep))
                 {
-                    uint16_t keep = bit(a) | bit(b);
-                    for (uint8_t c = 0; c < 9; ++c)
-                        if (pos[a] & (1u << c) &&
-                            s.removeCandidatesMask(r, c, ~keep))
-                        {
-                            changed = true; ++localRemove;
-                        }
+                    changed = true;
+                    ++localRemove;
                 }
+            }
+        }
     }
 
-    if (changed) {
-        logicalStats.data[LS_HIDDEN_PAIR][0]++;
-        logicalStats.data[LS_HIDDEN_PAIR][1] += localRemove;
+    if (changed)
+    {
+        logicalStats.data[HIDDEN_SUBSET_ID[size]][0]++;
+        logicalStats.data[HIDDEN_SUBSET_ID[size]][1] += localRemove;
     }
+
     return changed;
 }
 
-bool LogicalSolver::applyNakedTriple(Sudoku& s)
+bool LogicalSolver::applyUniqueRectangle(Sudoku& s)
 {
     bool changed = false;
     uint32_t localRemove = 0;
 
-    auto handleUnit = [&](const int idx[9]) {
-        for (int a = 0; a < 7; ++a)
-            for (int b = a + 1; b < 8; ++b)
-                for (int c = b + 1; c < 9; ++c)
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+
+    auto removeMask = [&](int i, uint16_t kill) {
+        if (grid[i] != UNASSIGNED) return;
+        if (s.removeCandidatesMask(i / 9, i % 9, kill))
+        {
+            changed = true;
+            ++localRemove;
+        }
+        };
+
+    // corners: 0 = (r1,c1), 1 = (r1,c2), 2 = (r2,c1), 3 = (r2,c2)
+    // diagonal corner pairs are (0,3) and (1,2)
+    for (int r1 = 0; r1 < 8; ++r1)
+        for (int r2 = r1 + 1; r2 < 9; ++r2)
+            for (int c1 = 0; c1 < 8; ++c1)
+                for (int c2 = c1 + 1; c2 < 9; ++c2)
                 {
-                    int i1 = idx[a], i2 = idx[b], i3 = idx[c];
+                    // deadly pattern must span exactly two boxes
+                    bool sameBand = (r1 / 3) == (r2 / 3);
+                    bool sameStack = (c1 / 3) == (c2 / 3);
+                    if (sameBand == sameStack) continue;
+
+                    int idx[4] = { POS(r1, c1), POS(r1, c2), POS(r2, c1), POS(r2, c2) };
+                    if (grid[idx[0]] != UNASSIGNED || grid[idx[1]] != UNASSIGNED ||
+                        grid[idx[2]] != UNASSIGNED || grid[idx[3]] != UNASSIGNED)
+                        continue;
+
+                    uint16_t m[4] = { cand[idx[0]], cand[idx[1]], cand[idx[2]], cand[idx[3]] };
+
+                    // every bivalue corner equals the common mask, so the UR pair
+                    // is exactly the intersection of all four corners
+                    uint16_t pair = m[0] & m[1] & m[2] & m[3];
+                    if (std::popcount(pair) != 2) continue;
 
-                    if (s.get(i1 / 9, i1 % 9) != UNASSIGNED) continue;
-                    if (s.get(i2 / 9, i2 % 9) != UNASSIGNED) continue;
-                    if (s.get(i3 / 9, i3 % 9) != UNASSIGNED) continue;
+                    int floorBits = 0;
+                    for (int k = 0; k < 4; ++k)
+                        if (m[k] == pair) floorBits |= 1 << k;
 
-                    uint16_t m1 = s.getCandidates(i1 / 9, i1 % 9);
-                    uint16_t m2 = s.getCandidates(i2 / 9, i2 % 9);
-                    uint16_t m3 = s.getCandidates(i3 / 9, i3 % 9);
+                    int floorCount = std::popcount((unsigned)floorBits);
+                    if (floorCount < 2 || floorCount == 4) continue;
 
-                    uint16_t uni = m1 | m2 | m3;
-                    if (std::popcount(uni) != 3) continue;
+                    // Type 1: three bivalue corners -> pair is removed from the fourth
+                    if (floorCount == 3)
+                    {
+                        int k = std::countr_zero((unsigned)(~floorBits & 0xF));
+                        removeMask(idx[k], pair);
+                        continue;
+                    }
+
+                    // Types 2-4 need the floor on one row/column, roof on the other
+                    if (floorBits == 0b1001 || floorBits == 0b0110) continue;
+
+                    int roofBits = ~floorBits & 0xF;
+                    int x = std::countr_zero((unsigned)roofBits);
+                    int y = std::countr_zero((unsigned)(roofBits & (roofBits - 1)));
+                    int rx = idx[x], ry = idx[y];
+
+                    // units containing both roof cells (line, plus box if shared)
+                    int shared[2], sharedCount = 0;
+                    for (int u = 0; u < 3; ++u)
+                        if (UNITS.ofCell[rx][u] == UNITS.ofCell[ry][u])
+                            shared[sharedCount++] = UNITS.ofCell[rx][u];
+
+                    uint16_t extraX = cand[rx] & ~pair;
+                    uint16_t extraY = cand[ry] & ~pair;
 
-                    for (int k = 0; k < 9; ++k)
+                    // Type 2: same single extra digit -> it is true in one roof cell
+                    if (extraX == extraY && std::popcount(extraX) == 1)
                     {
-                        if (k == a || k == b || k == c) continue;
-                        int i = idx[k];
-                        if (s.get(i / 9, i % 9) != UNASSIGNED) continue;
+                        for (int u = 0; u < sharedCount; ++u)
+                            for (int k = 0; k < 9; ++k)
+                            {
+                                int i = UNITS.cells[shared[u]][k];
+                                if (i != rx && i != ry) removeMask(i, extraX);
+                            }
+                        continue;
+                    }
+
+                    for (int u = 0; u < sharedCount; ++u)
+                    {
+                        const uint8_t* cells = UNITS.cells[shared[u]];
+
+                        // Type 4: one pair digit locked to the roof in this unit
+                        // -> the other pair digit is removed from both roof cells
+                        uint16_t outside = 0;
+                        for (int k = 0; k < 9; ++k)
+                        {
+                            int i = cells[k];
+                            if (i != rx && i != ry && grid[i] == UNASSIGNED)
+                                outside |= cand[i];
+                        }
+
+                        uint16_t locked = pair & ~outside;
+                        if (locked && locked != pair)
+                        {
+                            removeMask(rx, pair & ~locked);
+                            removeMask(ry, pair & ~locked);
+                            break;
+                        }
+
+                        // Type 3: roof extras act as one pseudo-cell that forms a
+                        // naked subset with 1..3 other cells of the unit
+                        uint16_t extras = (cand[rx] | cand[ry]) & ~pair;
+                        int others[7], otherCount = 0;
+                        for (int k = 0; k < 9; ++k)
+                        {
+                            int i = cells[k];
+                            if (i != rx && i != ry && grid[i] == UNASSIGNED)
+                                others[otherCount++] = i;
+                        }
 
-                        if (s.removeCandidatesMask(i / 9, i % 9, uni))
+                        for (int sel = 1; sel < (1 << otherCount); ++sel)
                         {
-                            changed = true;
-                            ++localRemove;
+                            int size = std::popcount((unsigned)sel);
+                            if (size > 3) continue;
+
+                            uint16_t uni = extras;
+                            for (int k = 0; k < otherCount; ++k)
+                                if (sel & (1 << k)) uni |= cand[others[k]];
+                            if (std::popcount(uni) != size + 1) continue;
+
+                            for (int k = 0; k < otherCount; ++k)
+                                if (!(sel & (1 << k))) removeMask(others[k], uni);
+                            break;
                         }
                     }
                 }
-        };
 
-    // rows
-    for (int r = 0; r < 9; ++r) {
-        int idx[9];
-        for (int c = 0; c < 9; ++c) idx[c] = r * 9 + c;
-        handleUnit(idx);
+    if (changed)
+    {
+        logicalStats.data[LS_UNIQUE_RECTANGLE][0]++;
+        logicalStats.data[LS_UNIQUE_RECTANGLE][1] += localRemove;
     }
 
-    // columns
-    for (int c = 0; c < 9; ++c) {
-        int idx[9];
-        for (int r = 0; r < 9; ++r) idx[r] = r * 9 + c;
-        handleUnit(idx);
-    }
+    return changed;
+}
 
-    // boxes
-    for (int br = 0; br < 9; br += 3)
-        for (int bc = 0; bc < 9; bc += 3) {
-            int idx[9], p = 0;
-            for (int dr = 0; dr < 3; ++dr)
-                for (int dc = 0; dc < 3; ++dc)
-                    idx[p++] = (br + dr) * 9 + (bc + dc);
-            handleUnit(idx);
+bool LogicalSolver::applyBugPlusOne(Sudoku& s)
+{
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+
+    // BUG+1: every unsolved cell is bivalue except exactly one trivalue cell
+    int triCell = -1;
+    for (int i = 0; i < 81; ++i)
+    {
+        if (grid[i] != UNASSIGNED) continue;
+        int count = std::popcount(cand[i]);
+        if (count == 2) continue;
+        if (count == 3 && triCell < 0) { triCell = i; continue; }
+        return false;
+    }
+    if (triCell < 0) return false;
+
+    // The BUG state itself: without the extra candidate every digit would
+    // sit in exactly two cells of each unit (a deadly, multi-solution
+    // pattern). Checked in full so no earlier technique has to be assumed.
+    // The extra candidate is the one of the trivalue cell that appears three
+    // times in each of its units; placing it is the only way out.
+    uint8_t r = triCell / 9;
+    uint8_t c = triCell % 9;
+    const uint8_t* own = UNITS.ofCell[triCell];
+    uint16_t extra = 0;
+    for (int u = 0; u < UNIT_COUNT; ++u)
+    {
+        const uint8_t* cells = UNITS.cells[u];
+        bool mine = u == own[0] || u == own[1] || u == own[2];
+        for (uint8_t d = 1; d <= 9; ++d)
+        {
+            int count = 0;
+            for (int k = 0; k < 9; ++k)
+                count += grid[cells[k]] == UNASSIGNED && (cand[cells[k]] & bit(d));
+            if (count == 0 || count == 2) continue;
+            if (count != 3 || !mine || !(cand[triCell] & bit(d))) return false;
+            extra |= bit(d);
         }
+    }
+    if (!singleMask(extra)) return false;
+    uint8_t value = extractSingleValue(extra);
 
-    if (changed)
+    // three times in one of the cell's units means three times in all of them
+    for (int k = 0; k < 3; ++k)
     {
-        logicalStats.data[LS_NAKED_TRIPLE][0]++;
-        logicalStats.data[LS_NAKED_TRIPLE][1] += localRemove;
+        const uint8_t* cells = UNITS.cells[own[k]];
+        int count = 0;
+        for (int j = 0; j < 9; ++j)
+            count += grid[cells[j]] == UNASSIGNED && (cand[cells[j]] & bit(value));
+        if (count != 3) return false;
     }
 
-    return changed;
+    s.set(r, c, value);
+    s.updateCandidatesAfterSet(r, c, value);
+
+    logicalStats.data[LS_BUG_PLUS_ONE][0]++;
+    logicalStats.data[LS_BUG_PLUS_ONE][1]++;
+    return true;
 }
 
-bool LogicalSolver::applyHiddenTriple(Sudoku& s)
+// Singles-only propagation used by trial lookahead.
+// Returns false as soon as the grid becomes contradictory.
+static bool propagateSingles(Sudoku& s, int rounds)
 {
-    bool changed = false;
-    uint32_t localRemove = 0;
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
 
-    auto handleUnit = [&](const int idx[9]) {
-        uint16_t pos[10] = {};
+    for (int round = 0; round < rounds; ++round)
+    {
+        bool progressed = false;
 
-        for (int k = 0; k < 9; ++k)
+        // naked singles
+        for (int i = 0; i < 81; ++i)
+        {
+            if (grid[i] != UNASSIGNED) continue;
+            uint16_t m = cand[i];
+            if (m == 0) return false;
+            if (!singleMask(m)) continue;
+
+            uint8_t v = extractSingleValue(m);
+            s.set(i / 9, i % 9, v);
+            s.updateCandidatesAfterSet(i / 9, i % 9, v);
+            progressed = true;
+        }
+
+        // hidden singles (+ digits that lost every position)
+        for (int u = 0; u < UNIT_COUNT; ++u)
         {
-            int i = idx[k];
-            if (s.get(i / 9, i % 9) != UNASSIGNED) continue;
+            const uint8_t* cells = UNITS.cells[u];
+            uint16_t placed = 0, seenOnce = 0, seenTwice = 0;
 
-            uint16_t m = s.getCandidates(i / 9, i % 9);
-            for (uint8_t d = 1; d <= 9; ++d)
-                if (m & bit(d))
-                    pos[d] |= (1u << k);
+            for (int k = 0; k < 9; ++k)
+            {
+                int i = cells[k];
+                if (grid[i] != UNASSIGNED) { placed |= bit(grid[i]); continue; }
+                seenTwice |= seenOnce & cand[i];
+                seenOnce |= cand[i];
+            }
+
+            if ((placed | seenOnce) != FULL_MASK) return false;
+
+            uint16_t hidden = seenOnce & ~seenTwice & ~placed;
+            for (int k = 0; k < 9 && hidden; ++k)
+            {
+                int i = cells[k];
+                if (grid[i] != UNASSIGNED) continue;
+                uint16_t m = cand[i] & hidden;
+                if (!m) continue;
+                if (!singleMask(m)) return false; // two digits need the same cell
+
+                uint8_t v = extractSingleValue(m);
+                s.set(i / 9, i % 9, v);
+                s.updateCandidatesAfterSet(i / 9, i % 9, v);
+                hidden &= ~m;
+                progressed = true;
+            }
         }
 
-        for (uint8_t a = 1; a <= 7; ++a)
-            for (uint8_t b = a + 1; b <= 8; ++b)
-                for (uint8_t c = b + 1; c <= 9; ++c)
-                {
-                    uint16_t cells = pos[a] | pos[b] | pos[c];
-                    if (std::popcount(cells) != 3) continue;
+        if (!progressed) break;
+    }
+    return true;
+}
 
-                    // CRITICAL SAFETY CHECKS
-                    if (pos[a] == 0 || pos[b] == 0 || pos[c] == 0) continue;
-                    if ((pos[a] & cells) != pos[a]) continue;
-                    if ((pos[b] & cells) != pos[b]) continue;
-                    if ((pos[c] & cells) != pos[c]) continue;
+bool LogicalSolver::applyTrialPropagation(Sudoku& s)
+{
+    if (options.lookaheadDepth <= 0)
+        return false;
 
-                    uint16_t keepMask = bit(a) | bit(b) | bit(c);
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+    int budget = options.lookaheadBudget;
 
-                    for (int k = 0; k < 9; ++k)
-                    {
-                        if (!(cells & (1u << k))) continue;
-                        int i = idx[k];
+    // Tries both options of a binary choice. Returns true if the grid changed.
+    auto tryChoice = [&](int cellA, uint8_t valueA, int cellB, uint8_t valueB) -> bool
+        {
+            Sudoku branch[2] = { s, s };
+            bool alive[2];
+            int cells[2] = { cellA, cellB };
+            uint8_t values[2] = { valueA, valueB };
 
-                        if (s.removeCandidatesMask(i / 9, i % 9, ~keepMask))
-                        {
-                            changed = true;
-                            ++localRemove;
-                        }
-                    }
+            for (int k = 0; k < 2; ++k)
+            {
+                branch[k].set(cells[k] / 9, cells[k] % 9, values[k]);
+                branch[k].updateCandidatesAfterSet(cells[k] / 9, cells[k] % 9, values[k]);
+                alive[k] = propagateSingles(branch[k], options.lookaheadDepth);
+            }
+            budget -= 2;
+
+            // contradiction -> the other option holds (both dead: leave it to search)
+            if (alive[0] != alive[1])
+            {
+                int k = alive[0] ? 0 : 1;
+                s.set(cells[k] / 9, cells[k] % 9, values[k]);
+                s.updateCandidatesAfterSet(cells[k] / 9, cells[k] % 9, values[k]);
+                logicalStats.data[LS_TRIAL_PROPAGATION][1]++;
+                return true;
+            }
+            if (!alive[0])
+                return false;
+
+            // a branch that reached a full grid without contradiction is a solution
+            for (int k = 0; k < 2; ++k)
+                if (branch[k].isSolved())
+                {
+                    s = branch[k];
+                    logicalStats.data[LS_TRIAL_PROPAGATION][1]++;
+                    return true;
                 }
-        };
 
-    // rows
-    for (int r = 0; r < 9; ++r) {
-        int idx[9];
-        for (int c = 0; c < 9; ++c) idx[c] = r * 9 + c;
-        handleUnit(idx);
-    }
+            // keep what both branches agree on: a candidate survives only if
+            // it is still possible in at least one branch
+            uint32_t removed = 0;
+            for (int i = 0; i < 81; ++i)
+            {
+                if (grid[i] != UNASSIGNED) continue;
 
-    // columns
-    for (int c = 0; c < 9; ++c) {
-        int idx[9];
-        for (int r = 0; r < 9; ++r) idx[r] = r * 9 + c;
-        handleUnit(idx);
-    }
+                uint16_t allowed = 0;
+                for (int k = 0; k < 2; ++k)
+                {
+                    uint8_t v = branch[k].rawGrid()[i];
+                    allowed |= v ? bit(v) : branch[k].candidatesData()[i];
+                }
+
+                if (s.removeCandidatesMask(i / 9, i % 9, (uint16_t)~allowed))
+                    ++removed;
+            }
 
-    // boxes
-    for (int br = 0; br < 9; br += 3)
-        for (int bc = 0; bc < 9; bc += 3)
+            logicalStats.data[LS_TRIAL_PROPAGATION][1] += removed;
+            return removed != 0;
+        };
+
+    // bivalue cells
+    for (int i = 0; i < 81 && budget > 0; ++i)
+    {
+        if (grid[i] != UNASSIGNED || std::popcount(cand[i]) != 2) continue;
+
+        uint16_t m = cand[i];
+        uint8_t a = extractSingleValue(m);
+        uint8_t b = extractSingleValue(m & (m - 1));
+        if (tryChoice(i, a, i, b))
         {
-            int idx[9], p = 0;
-            for (int dr = 0; dr < 3; ++dr)
-                for (int dc = 0; dc < 3; ++dc)
-                    idx[p++] = (br + dr) * 9 + (bc + dc);
-            handleUnit(idx);
+            logicalStats.data[LS_TRIAL_PROPAGATION][0]++;
+            return true;
         }
+    }
 
-    if (changed)
+    // strong links: digits with exactly two positions in a unit
+    for (int u = 0; u < UNIT_COUNT && budget > 0; ++u)
     {
-        logicalStats.data[LS_HIDDEN_TRIPLE][0]++;
-        logicalStats.data[LS_HIDDEN_TRIPLE][1] += localRemove;
+        const uint8_t* cells = UNITS.cells[u];
+
+        for (uint8_t d = 1; d <= 9 && budget > 0; ++d)
+        {
+            int first = -1, second = -1, count = 0;
+            for (int k = 0; k < 9 && count <= 2; ++k)
+            {
+                int i = cells[k];
+                if (grid[i] != UNASSIGNED || !(cand[i] & bit(d))) continue;
+                if (count == 0) first = i; else second = i;
+                ++count;
+            }
+            if (count != 2) continue;
+
+            if (tryChoice(first, d, second, d))
+            {
+                logicalStats.data[LS_TRIAL_PROPAGATION][0]++;
+                return true;
+            }
+        }
     }
 
-    return changed;
-}
+    return false;
+}
\ No newline at end of file
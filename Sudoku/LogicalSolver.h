@@ -2,12 +2,6 @@
 #include "ISudokuSolver.h"
 #include "Sudoku.h"
 
-struct LogicalStats {
-	// [technique][metric]
-	// metric: 0 = hit, 1 = effect
-	uint32_t data[8][2] = {};
-};
-
 enum {
 	LS_NAKED_SINGLE = 0,
 	LS_HIDDEN_SINGLE,
@@ -17,25 +11,109 @@ enum {
 	LS_HIDDEN_PAIR,
 	LS_NAKED_TRIPLE,
 	LS_HIDDEN_TRIPLE,
+	LS_NAKED_QUAD,
+	LS_HIDDEN_QUAD,
+	LS_UNIQUE_RECTANGLE,
+	LS_BUG_PLUS_ONE,
+	LS_TRIAL_PROPAGATION,
+	LS_COUNT
+};
+
+struct LogicalStats {
+	// [technique][metric]
+	// metric: 0 = hit, 1 = effect
+	uint32_t data[LS_COUNT][2] = {};
+};
+
+// Per-technique cost accounting: calls, TSC cycles, and "wasted" calls
+// that scanned the grid without changing anything. Only collected when
+// built with LOGICAL_PROFILE=1; otherwise the timing code compiles away
+// and the counters stay zero.
+#ifndef LOGICAL_PROFILE
+#define LOGICAL_PROFILE 0
+#endif
+
+struct LogicalProfile {
+	// [technique]
+	uint64_t calls[LS_COUNT] = {};
+	uint64_t cycles[LS_COUNT] = {};
+	uint64_t wastedCalls[LS_COUNT] = {};
+	uint64_t wastedCycles[LS_COUNT] = {};
+};
+
+#if LOGICAL_PROFILE
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// times one technique call; a call that returns false is a wasted scan
+template<class F>
+inline bool logicalProfiled(LogicalProfile& p, int id, F&& step)
+{
+	uint64_t t0 = __rdtsc();
+	bool progressed = step();
+	uint64_t dt = __rdtsc() - t0;
+
+	p.calls[id]++;
+	p.cycles[id] += dt;
+	if (!progressed)
+	{
+		p.wastedCalls[id]++;
+		p.wastedCycles[id] += dt;
+	}
+	return progressed;
+}
+#define LS_STEP(id, call) logicalProfiled(logicalProfile, id, [&] { return call; })
+#else
+#define LS_STEP(id, call) (call)
+#endif
+
+struct LogicalOptions {
+	// Unique Rectangle (type 1-4) and BUG+1 rely on the puzzle having exactly
+	// one solution. On multi-solution inputs they can remove valid candidates,
+	// so they only run when explicitly enabled.
+	bool assumeUnique = false;
+
+	// Bounded lookahead once every technique stalls: each option of a bivalue
+	// cell or strong link is tried on a scratch copy with singles-only
+	// propagation. Contradicting options are removed, conclusions shared by
+	// both options are kept. Depth = singles rounds per trial (0 disables),
+	// budget = trials per stall.
+	int lookaheadDepth = 16;
+	int lookaheadBudget = 96;
 };
 
 
 class LogicalSolver : public ISudokuSolver
 {
-	
+	friend struct LogicalStepAccess;   // static pipelines, see LogicalPipeline.h
+
 protected:
 	virtual bool applyNakedSingle(Sudoku& s);
 	bool applyHiddenSingle(Sudoku& s);
-	bool applyLockedCandidatesPointing(Sudoku& sudoku);
-	bool applyLockedCandidatesClaiming(Sudoku& sudoku);
-	bool applyNakedPair(Sudoku& s);
-	bool applyHiddenPair(Sudoku& s);
+	virtual bool applyLockedCandidatesPointing(Sudoku& sudoku);
+	virtual bool applyLockedCandidatesClaiming(Sudoku& sudoku);
+	virtual bool applyNakedSubset(Sudoku& s, int size);  // size 2..4
+	virtual bool applyHiddenSubset(Sudoku& s, int size); // size 2..4
 	bool applyLogicalStep(Sudoku& s);
-	bool applyNakedTriple(Sudoku& s);
-	bool applyHiddenTriple(Sudoku& s);
+	bool applyUniqueRectangle(Sudoku& s);
+	bool applyBugPlusOne(Sudoku& s);
+	bool applyTrialPropagation(Sudoku& s);
 	LogicalStats logicalStats;
+	LogicalProfile logicalProfile;
+	LogicalOptions options;
 public:
+	LogicalSolver() = default;
+	explicit LogicalSolver(const LogicalOptions& opts) : options(opts) {}
+
 	const LogicalStats& getLogicalStats() const { return logicalStats; }
+	const LogicalProfile& getLogicalProfile() const { return logicalProfile; }
+	static const char* techniqueName(int id);
+	const LogicalOptions& getOptions() const { return options; }
 	const char* getName() const override { return "Logical Solver"; }
 	SolveResult solve(Sudoku& s);
+	SolveResult solveWithStats(Sudoku& s, SearchStats& search) override;
+	SolveResult solveWithBudget(Sudoku& s, SearchStats& search, const SolveBudget& budget) override;
 };
\ No newline at end of file
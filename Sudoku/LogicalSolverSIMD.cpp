@@ -1,6 +1,8 @@
 #include "LogicalSolverSIMD.h"
 #include "simd_utils.h"
 
+#include <cstring>
+
 bool LogicalSolverSIMD::applyNakedSingle(Sudoku& s)
 {
     const uint16_t* cand = s.candidatesData();
@@ -67,3 +69,395 @@ bool LogicalSolverSIMD::applyNakedSingle(Sudoku& s)
 
     return true;
 }
+
+// ============================================================
+// Unit lane layout
+// ============================================================
+
+// Every row and column as one 16-lane vector (lanes 9..15 = 0).
+// Solved cells are stored as 0, so stale candidate masks never leak in.
+struct alignas(32) UnitLanes
+{
+    uint16_t rows[9][16];  // lane = column
+    uint16_t cols[9][16];  // lane = row
+};
+
+static inline void loadUnitLanes(const Sudoku& s, UnitLanes& lanes)
+{
+    std::memset(&lanes, 0, sizeof(lanes));
+
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+
+    for (int i = 0; i < 81; ++i)
+    {
+        uint16_t m = grid[i] == UNASSIGNED ? cand[i] : 0;
+        int r = i / 9, c = i % 9;
+        lanes.rows[r][c] = m;
+        lanes.cols[c][r] = m;
+    }
+}
+
+// ============================================================
+// Locked candidates
+// ============================================================
+
+// Box-line segment ORs:
+//   rowSeg[S][r] = candidates of row r inside stack S
+//   colSeg[R][c] = candidates of column c inside band R
+struct alignas(32) LineSegments
+{
+    uint16_t rowSeg[3][16];
+    uint16_t colSeg[3][16];
+};
+
+static inline void reduceSegments(const UnitLanes& lanes, LineSegments& seg)
+{
+    for (int k = 0; k < 3; ++k)
+    {
+        store_u16(seg.rowSeg[k], or3_epi16(
+            load_u16(lanes.cols[3 * k]), load_u16(lanes.cols[3 * k + 1]), load_u16(lanes.cols[3 * k + 2])));
+        store_u16(seg.colSeg[k], or3_epi16(
+            load_u16(lanes.rows[3 * k]), load_u16(lanes.rows[3 * k + 1]), load_u16(lanes.rows[3 * k + 2])));
+    }
+}
+
+// Removes killRow[r][S] from cells (r, stack S) and killCol[R][c] from cells
+// (band R, c). Only unsolved cells are written back.
+// Returns the number of removed candidates.
+static uint32_t applyLineKills(Sudoku& s, UnitLanes& lanes,
+    const uint16_t killRow[9][3], const uint16_t killCol[3][16])
+{
+    uint32_t removed = 0;
+    uint16_t* cand = s.rawCandidatesMutable();
+    const uint8_t* grid = s.rawGrid();
+
+    for (int r = 0; r < 9; ++r)
+    {
+        uint16_t k0 = killRow[r][0], k1 = killRow[r][1], k2 = killRow[r][2];
+        __m256i kill = _mm256_or_si256(
+            _mm256_setr_epi16(k0, k0, k0, k1, k1, k1, k2, k2, k2, 0, 0, 0, 0, 0, 0, 0),
+            load_u16(killCol[r / 3]));
+
+        __m256i row = load_u16(lanes.rows[r]);
+        __m256i hit = _mm256_and_si256(row, kill);
+        if (!any_lane(mask_nonzero_epi16(hit)))
+            continue;
+
+        removed += popcount_sum_epi16(hit);
+        store_u16(lanes.rows[r], _mm256_andnot_si256(kill, row));
+
+        for (int c = 0; c < 9; ++c)
+            if (grid[POS(r, c)] == UNASSIGNED)
+                cand[POS(r, c)] = lanes.rows[r][c];
+    }
+    return removed;
+}
+
+bool LogicalSolverSIMD::applyLockedCandidatesPointing(Sudoku& s)
+{
+    UnitLanes lanes;
+    LineSegments seg;
+    loadUnitLanes(s, lanes);
+    reduceSegments(lanes, seg);
+
+    uint16_t killRow[9][3] = {};
+    alignas(32) uint16_t killCol[3][16] = {};
+
+    for (int R = 0; R < 3; ++R)
+        for (int S = 0; S < 3; ++S)
+            for (int i = 0; i < 3; ++i)
+            {
+                // digits of box (R,S) that only appear in its i-th row
+                int r = 3 * R + i;
+                uint16_t onlyRow = seg.rowSeg[S][r] &
+                    ~seg.rowSeg[S][3 * R + (i + 1) % 3] & ~seg.rowSeg[S][3 * R + (i + 2) % 3];
+                if (onlyRow)
+                    for (int S2 = 0; S2 < 3; ++S2)
+                        if (S2 != S) killRow[r][S2] |= onlyRow;
+
+                // digits of box (R,S) that only appear in its i-th column
+                int c = 3 * S + i;
+                uint16_t onlyCol = seg.colSeg[R][c] &
+                    ~seg.colSeg[R][3 * S + (i + 1) % 3] & ~seg.colSeg[R][3 * S + (i + 2) % 3];
+                if (onlyCol)
+                    for (int R2 = 0; R2 < 3; ++R2)
+                        if (R2 != R) killCol[R2][c] |= onlyCol;
+            }
+
+    uint32_t removed = applyLineKills(s, lanes, killRow, killCol);
+    if (!removed)
+        return false;
+
+    logicalStats.data[LS_LOCKED_POINTING][0]++;
+    logicalStats.data[LS_LOCKED_POINTING][1] += removed;
+    return true;
+}
+
+bool LogicalSolverSIMD::applyLockedCandidatesClaiming(Sudoku& s)
+{
+    UnitLanes lanes;
+    LineSegments seg;
+    loadUnitLanes(s, lanes);
+    reduceSegments(lanes, seg);
+
+    uint16_t killRow[9][3] = {};
+    alignas(32) uint16_t killCol[3][16] = {};
+
+    for (int k = 0; k < 9; ++k)
+        for (int b = 0; b < 3; ++b)
+        {
+            // digits of row k that only appear inside stack b
+            uint16_t onlyStack = seg.rowSeg[b][k] &
+                ~seg.rowSeg[(b + 1) % 3][k] & ~seg.rowSeg[(b + 2) % 3][k];
+            if (onlyStack)
+                for (int r = 3 * (k / 3); r < 3 * (k / 3) + 3; ++r)
+                    if (r != k) killRow[r][b] |= onlyStack;
+
+            // digits of column k that only appear inside band b
+            uint16_t onlyBand = seg.colSeg[b][k] &
+                ~seg.colSeg[(b + 1) % 3][k] & ~seg.colSeg[(b + 2) % 3][k];
+            if (onlyBand)
+                for (int c = 3 * (k / 3); c < 3 * (k / 3) + 3; ++c)
+                    if (c != k) killCol[b][c] |= onlyBand;
+        }
+
+    uint32_t removed = applyLineKills(s, lanes, killRow, killCol);
+    if (!removed)
+        return false;
+
+    logicalStats.data[LS_LOCKED_CLAIMING][0]++;
+    logicalStats.data[LS_LOCKED_CLAIMING][1] += removed;
+    return true;
+}
+
+// ============================================================
+// Pairs
+// ============================================================
+
+// Loads one group of units from the unit table as lane vectors:
+// first = 0 rows, 9 columns, 18 boxes.
+static inline void loadUnitGroup(const Sudoku& s, int first, uint16_t units[9][16])
+{
+    std::memset(units, 0, sizeof(uint16_t) * 9 * 16);
+
+    const uint8_t* grid = s.rawGrid();
+    const uint16_t* cand = s.candidatesData();
+
+    for (int u = 0; u < 9; ++u)
+        for (int k = 0; k < 9; ++k)
+        {
+            int i = UNITS.cells[first + u][k];
+            units[u][k] = grid[i] == UNASSIGNED ? cand[i] : 0;
+        }
+}
+
+// Writes a unit group back to unsolved cells.
+// Returns the number of cells whose candidates changed.
+static inline uint32_t storeUnitGroup(Sudoku& s, int first, const uint16_t units[9][16])
+{
+    uint32_t changed = 0;
+    uint16_t* cand = s.rawCandidatesMutable();
+    const uint8_t* grid = s.rawGrid();
+
+    for (int u = 0; u < 9; ++u)
+        for (int k = 0; k < 9; ++k)
+        {
+            int i = UNITS.cells[first + u][k];
+            if (grid[i] == UNASSIGNED && cand[i] != units[u][k])
+            {
+                cand[i] = units[u][k];
+                ++changed;
+            }
+        }
+    return changed;
+}
+
+// Two cells of a unit with the same bivalue mask remove both digits
+// from every other cell of the unit.
+static void nakedPairsInUnits(uint16_t units[9][16])
+{
+    for (int u = 0; u < 9; ++u)
+    {
+        __m256i v = load_u16(units[u]);
+
+        // members are fixed when the unit is entered (as in the scalar
+        // engine), their masks are read live
+        const uint32_t members = lane_bits_epi16(mask_two_bits_epi16(v));
+        uint32_t pairs = members;
+
+        while (pairs)
+        {
+            // units[u] is kept in sync with v, an earlier pair may have
+            // shrunk this lane
+            int lane = std::countr_zero(pairs);
+            uint16_t m = units[u][lane];
+            pairs &= pairs - 1;
+            if (std::popcount(m) != 2) continue;
+
+            uint32_t same = members & lane_bits_epi16(_mm256_cmpeq_epi16(v, vone16(m)));
+            pairs &= ~same;
+            if (std::popcount(same) != 2) continue;
+
+            __m256i kill = _mm256_andnot_si256(expand_lane_bits_epi16(same), vone16(m));
+            v = _mm256_andnot_si256(kill, v);
+            store_u16(units[u], v);
+        }
+    }
+}
+
+// Two digits confined to the same two cells of a unit remove every
+// other digit from those cells.
+static void hiddenPairsInUnits(uint16_t units[9][16])
+{
+    for (int u = 0; u < 9; ++u)
+    {
+        __m256i v = load_u16(units[u]);
+
+        // pos[d] = lanes holding digit d
+        uint32_t pos[10] = {};
+        uint16_t members = 0;
+        for (uint8_t d = 1; d <= 9; ++d)
+        {
+            __m256i b = vone16(bit(d));
+            pos[d] = lane_bits_epi16(_mm256_cmpeq_epi16(_mm256_and_si256(v, b), b));
+            if (std::popcount(pos[d]) == 2) members |= bit(d);
+        }
+
+        for (uint16_t ma = members; ma; ma &= ma - 1)
+        {
+            uint8_t a = (uint8_t)(std::countr_zero(ma) + 1);
+            for (uint16_t mb = ma & (ma - 1); mb; mb &= mb - 1)
+            {
+                uint8_t b = (uint8_t)(std::countr_zero(mb) + 1);
+                if (pos[a] != pos[b]) continue;
+
+                uint16_t drop = FULL_MASK & ~(bit(a) | bit(b));
+                __m256i kill = _mm256_and_si256(expand_lane_bits_epi16(pos[a]), vone16(drop));
+                v = _mm256_andnot_si256(kill, v);
+            }
+        }
+        store_u16(units[u], v);
+    }
+}
+
+// Rows, then columns, then boxes, each group seeing the eliminations of
+// the previous one (same order as the scalar subset engine).
+static uint32_t applyPairsByGroup(Sudoku& s, void (*pairsInUnits)(uint16_t[9][16]))
+{
+    alignas(32) uint16_t units[9][16];
+    uint32_t changed = 0;
+
+    for (int first = 0; first < UNIT_COUNT; first += 9)
+    {
+        loadUnitGroup(s, first, units);
+        pairsInUnits(units);
+        changed += storeUnitGroup(s, first, units);
+    }
+    return changed;
+}
+
+bool LogicalSolverSIMD::applyNakedSubset(Sudoku& s, int size)
+{
+    if (size != 2)
+        return LogicalSolver::applyNakedSubset(s, size);
+
+    uint32_t changed = applyPairsByGroup(s, nakedPairsInUnits);
+    if (!changed)
+        return false;
+
+    logicalStats.data[LS_NAKED_PAIR][0]++;
+    logicalStats.data[LS_NAKED_PAIR][1] += changed;
+    return true;
+}
+
+bool LogicalSolverSIMD::applyHiddenSubset(Sudoku& s, int size)
+{
+    if (size != 2)
+        return LogicalSolver::applyHiddenSubset(s, size);
+
+    uint32_t changed = applyPairsByGroup(s, hiddenPairsInUnits);
+    if (!changed)
+        return false;
+
+    logicalStats.data[LS_HIDDEN_PAIR][0]++;
+    logicalStats.data[LS_HIDDEN_PAIR][1] += changed;
+    return true;
+}
+
+// ============================================================
+// Differential check
+// ============================================================
+
+static bool sameUnsolvedState(const Sudoku& a, const Sudoku& b)
+{
+    for (int i = 0; i < 81; ++i)
+    {
+        if (a.rawGrid()[i] != b.rawGrid()[i])
+            return false;
+        if (a.rawGrid()[i] == UNASSIGNED && a.candidatesData()[i] != b.candidatesData()[i])
+            return false;
+    }
+    return true;
+}
+
+size_t LogicalSolverSIMD::differentialCheck(const std::vector<Sudoku>& puzzles, std::ostream& log)
+{
+    // The scalar locked-candidate pass sees its own eliminations box by box,
+    // the SIMD pass works from one snapshot, so single calls may differ.
+    // Both sides are therefore compared at their fixpoint.
+    struct Technique
+    {
+        const char* name;
+        bool (*scalar)(LogicalSolverSIMD&, Sudoku&);
+        bool (*simd)(LogicalSolverSIMD&, Sudoku&);
+    };
+
+    static const Technique techniques[] = {
+        { "LockedPointing",
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.LogicalSolver::applyLockedCandidatesPointing(s); },
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.applyLockedCandidatesPointing(s); } },
+        { "LockedClaiming",
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.LogicalSolver::applyLockedCandidatesClaiming(s); },
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.applyLockedCandidatesClaiming(s); } },
+        { "NakedPair",
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.LogicalSolver::applyNakedSubset(s, 2); },
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.applyNakedSubset(s, 2); } },
+        { "HiddenPair",
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.LogicalSolver::applyHiddenSubset(s, 2); },
+            [](LogicalSolverSIMD& ls, Sudoku& s) { return ls.applyHiddenSubset(s, 2); } },
+    };
+
+    LogicalSolverSIMD solver;
+    size_t mismatches = 0;
+    size_t states = 0;
+
+    for (size_t p = 0; p < puzzles.size(); ++p)
+    {
+        Sudoku state = puzzles[p];
+        state.recomputeCandidates();
+
+        do
+        {
+            ++states;
+            for (const Technique& t : techniques)
+            {
+                Sudoku a = state;
+                Sudoku b = state;
+                while (t.scalar(solver, a));
+                while (t.simd(solver, b));
+
+                if (!sameUnsolvedState(a, b))
+                {
+                    if (mismatches < 10)
+                        log << "[SIMD DIFF] " << t.name << " mismatch on puzzle " << p << "\n";
+                    ++mismatches;
+                }
+            }
+        } while (!state.isSolved() && solver.applyLogicalStep(state));
+    }
+
+    log << "[SIMD DIFF] " << states << " states checked, "
+        << mismatches << " mismatches\n";
+    return mismatches;
+}
@@ -1,11 +1,23 @@
 #pragma once
+#include <vector>
+#include <ostream>
 #include "LogicalSolver.h"
 
 class LogicalSolverSIMD : public  LogicalSolver
 {
+	friend struct LogicalStepAccess;
+
 protected:
 	bool applyNakedSingle(Sudoku& s) override; // Add this line to declare the override
+	bool applyLockedCandidatesPointing(Sudoku& s) override;
+	bool applyLockedCandidatesClaiming(Sudoku& s) override;
+	bool applyNakedSubset(Sudoku& s, int size) override;  // AVX2 for pairs, scalar otherwise
+	bool applyHiddenSubset(Sudoku& s, int size) override; // AVX2 for pairs, scalar otherwise
 public:
+	using LogicalSolver::LogicalSolver;
 	const char* getName() const override { return "Logical Solver SIMD"; }
 
+	// Differential check of every vectorized technique against its scalar
+	// version on states taken along a logical solve. Returns mismatch count.
+	static size_t differentialCheck(const std::vector<Sudoku>& puzzles, std::ostream& log);
 };
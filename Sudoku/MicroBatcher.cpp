@@ -0,0 +1,135 @@
+#include "MicroBatcher.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MicroBatcher::MicroBatcher(const SolverFactory& factory, const BatchOptions& opts, std::function<void()> after)
+    : options(opts), afterBatch(std::move(after))
+{
+    options.maxBatch = std::max<size_t>(1, options.maxBatch);
+    unsigned n = options.workers;
+    if (!n)
+    {
+        n = std::thread::hardware_concurrency();
+        n = n ? n : 1;
+    }
+
+    engines.reserve(n);
+    for (unsigned t = 0; t < n; ++t)
+    {
+        engines.push_back(factory());
+        if (!engines.back())
+            throw std::invalid_argument("MicroBatcher: solver factory returned no engine");
+    }
+
+    workers.reserve(n);
+    for (unsigned t = 0; t < n; ++t)
+        workers.emplace_back([this, t]() { workerLoop(*engines[t]); });
+}
+
+MicroBatcher::~MicroBatcher()
+{
+    shutdown();
+}
+
+bool MicroBatcher::cancel(const Ticket& ticket)
+{
+    RequestState expected = RequestState::Queued;
+    return ticket && ticket->compare_exchange_strong(expected, RequestState::Cancelled);
+}
+
+void MicroBatcher::submit(const Sudoku& sudoku, Callback done, Ticket ticket)
+{
+    size_t queued;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back({ sudoku, std::move(done), std::move(ticket), std::chrono::steady_clock::now() });
+        queued = queue.size();
+    }
+    requests.fetch_add(1, std::memory_order_relaxed);
+
+    // first request starts a window, a full batch ends it early
+    if (queued == 1 || queued >= options.maxBatch)
+        wake.notify_one();
+}
+
+void MicroBatcher::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping && workers.empty())
+            return;
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& th : workers)
+        th.join();
+    workers.clear();
+}
+
+void MicroBatcher::workerLoop(ISudokuSolver& solver)
+{
+    std::vector<Request> batch;
+    batch.reserve(options.maxBatch);
+    Trace::nameThread("batch worker");
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return;   // stopping and drained
+
+            // let the batch fill until the oldest request has waited 'window'
+            auto deadline = queue.front().arrival + options.window;
+            wake.wait_until(guard, deadline, [&] {
+                return stopping || queue.size() >= options.maxBatch;
+            });
+            if (queue.empty())
+                continue; // another worker took it
+
+            size_t n = std::min(queue.size(), options.maxBatch);
+            for (size_t i = 0; i < n; ++i)
+            {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+
+            // leftovers start the next window on another worker
+            if (!queue.empty())
+                wake.notify_one();
+        }
+
+        TRACE_SCOPE("batch", "serve", (int64_t)batch.size());
+        for (Request& r : batch)
+        {
+            if (r.ticket)
+            {
+                RequestState expected = RequestState::Queued;
+                if (!r.ticket->compare_exchange_strong(expected, RequestState::Running))
+                    continue;   // cancelled while queued
+            }
+
+            SolveResult result = solver.solve(r.sudoku);
+            if (r.ticket)
+                r.ticket->store(RequestState::Done, std::memory_order_release);
+
+            // an exception leaving the thread function would terminate the
+            // process; the rest of the batch still gets its answers
+            try {
+                r.done(r.sudoku, result);
+            }
+            catch (...) {
+                callbackErrors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        completed.fetch_add(batch.size(), std::memory_order_relaxed);
+        batches.fetch_add(1, std::memory_order_relaxed);
+        batch.clear();
+
+        if (afterBatch)
+            afterBatch();
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ISudokuSolver.h"
+
+struct BatchOptions
+{
+    size_t maxBatch = 64;                        // requests per batch
+    std::chrono::microseconds window{ 200 };     // max wait for a batch to fill
+    unsigned workers = 0;                        // 0 = hardware_concurrency
+};
+
+// Collects concurrent solve requests into small batches: a worker takes the
+// queue head, waits at most 'window' (from the oldest request) for up to
+// maxBatch requests, then solves the whole batch without touching the queue
+// lock again. One lock round trip and one wakeup per batch instead of per
+// request; completion callbacks run on the worker thread.
+//
+// Every worker solves with its own engine from the factory: engines keep
+// per-instance state while solving (LogicalSolver's technique counters,
+// search scratch), so one instance must not serve several threads.
+class MicroBatcher
+{
+public:
+    using Callback = std::function<void(Sudoku& sudoku, SolveResult result)>;
+    using SolverFactory = std::function<std::unique_ptr<ISudokuSolver>()>;
+
+    // Optional per-request state for cancellation: a worker only runs a
+    // request it can move from Queued to Running; cancel() moves it to
+    // Cancelled instead and the callback is never invoked.
+    enum class RequestState : uint8_t { Queued, Running, Done, Cancelled };
+    using Ticket = std::shared_ptr<std::atomic<RequestState>>;
+
+    static Ticket makeTicket() { return std::make_shared<std::atomic<RequestState>>(RequestState::Queued); }
+    static bool cancel(const Ticket& ticket);
+
+    // one engine per worker; throws std::invalid_argument if the factory
+    // returns nullptr
+    MicroBatcher(const SolverFactory& factory, const BatchOptions& options,
+        std::function<void()> afterBatch = nullptr);
+    ~MicroBatcher();
+
+    void submit(const Sudoku& sudoku, Callback done, Ticket ticket = nullptr);
+
+    // waits for queued work, then stops the workers
+    void shutdown();
+
+    uint64_t requestCount() const { return requests.load(std::memory_order_relaxed); }
+    uint64_t completedCount() const { return completed.load(std::memory_order_relaxed); }
+    uint64_t batchCount() const { return batches.load(std::memory_order_relaxed); }
+    // callbacks that threw; the worker catches them and carries on
+    uint64_t callbackErrorCount() const { return callbackErrors.load(std::memory_order_relaxed); }
+
+private:
+    struct Request
+    {
+        Sudoku sudoku;
+        Callback done;
+        Ticket ticket;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    void workerLoop(ISudokuSolver& solver);
+
+    std::vector<std::unique_ptr<ISudokuSolver>> engines;   // one per worker
+    BatchOptions options;
+    std::function<void()> afterBatch;
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<Request> queue;
+    bool stopping = false;
+
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> requests{ 0 };
+    std::atomic<uint64_t> completed{ 0 };
+    std::atomic<uint64_t> batches{ 0 };
+    std::atomic<uint64_t> callbackErrors{ 0 };
+};
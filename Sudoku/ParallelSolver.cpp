@@ -1,10 +1,13 @@
 #include "ParallelSolver.h"
+#include "Trace.h"
+#include <chrono>
 #include <iostream>
 
 SolveStats ParallelSolver::solveAll(
     ISudokuSolver& solver,
     std::vector<Sudoku>& sudokus,
-    unsigned threadCount)
+    unsigned threadCount,
+    LatencyReport* latency)
 {
     const unsigned hw = std::thread::hardware_concurrency();
     const unsigned threads =
@@ -15,40 +18,91 @@ SolveStats ParallelSolver::solveAll(
     std::atomic<size_t> logical{ 0 };
     std::atomic<size_t> backtracking{ 0 };
     std::atomic<size_t> unsolvable{ 0 };
+    std::atomic<size_t> budgetExceeded{ 0 };
+
+    // per-thread search counters / latency reports, merged after join
+    struct alignas(64) ThreadSearch { SearchStats s; }; // no false sharing
+    std::vector<ThreadSearch> searches(threads);
+    std::vector<LatencyReport> reports;
+    if (latency)
+        reports.assign(threads, LatencyReport(latency->capacity()));
+
+    const bool tracing = TRACE_ENABLED();
+    const uint64_t slowNs = Trace::slowPuzzleNs();
 
     std::vector<std::thread> pool;
     pool.reserve(threads);
 
     for (unsigned t = 0; t < threads; ++t)
     {
-        pool.emplace_back([&]()
+        pool.emplace_back([&, t]()
             {
+                using Clock = std::chrono::steady_clock;
+
+                // one span per worker (arg = puzzles taken) shows imbalance,
+                // plus one per puzzle over Trace::slowPuzzleNs
+                uint64_t traceStart = tracing ? Trace::now() : 0;
+                int64_t taken = 0;
+                if (tracing)
+                    Trace::nameThread("parallel worker");
+
                 while (true)
                 {
                     size_t i = index.fetch_add(1, std::memory_order_relaxed);
                     if (i >= sudokus.size())
                         break;
+                    ++taken;
+
+                    SolveResult r;
+                    if (latency || tracing)
+                    {
+                        Clock::time_point t0 = Clock::now();
+                        r = solver.solveWithStats(sudokus[i], searches[t].s);
+                        Clock::time_point t1 = Clock::now();
+                        uint64_t ns = (uint64_t)std::chrono::duration_cast<
+                            std::chrono::nanoseconds>(t1 - t0).count();
+                        if (latency)
+                            reports[t].record(i, r, ns);
+                        if (tracing && ns >= slowNs)
+                        {
+                            uint64_t end = Trace::now();
+                            Trace::record("slow puzzle", "puzzle", end - ns, end, (int64_t)i);
+                        }
+                    }
+                    else
+                        r = solver.solveWithStats(sudokus[i], searches[t].s);
 
-                    SolveResult r = solver.solve(sudokus[i]);
                     if (r == SolveResult::AlreadySolved)
 						++alreadySolved;
                     else if (r == SolveResult::SolvedByLogical)
                         ++logical;
                     else if (r == SolveResult::SolvedByBacktracking)
                         ++backtracking;
+                    else if (r == SolveResult::BudgetExceeded)
+                        ++budgetExceeded;
                     else
                         ++unsolvable;
                 }
+
+                if (tracing)
+                    Trace::record("worker", "parallel", traceStart, Trace::now(), taken);
             });
     }
 
     for (auto& th : pool)
         th.join();
 
+    if (latency)
+        for (const LatencyReport& r : reports)
+            latency->merge(r);
+
     SolveStats stats;
 	stats.alreadySolved = alreadySolved.load();
     stats.logical = logical.load();
     stats.backtracking = backtracking.load();
     stats.unsolvable = unsolvable.load();
+    stats.budgetExceeded = budgetExceeded.load();
+    for (const ThreadSearch& ts : searches)
+        stats.search.merge(ts.s);
     return stats;
 }
@@ -3,6 +3,7 @@
 #include <thread>
 #include <atomic>
 #include "ISudokuSolver.h"
+#include "LatencyHistogram.h"
 
 class ParallelSolver
 {
@@ -10,5 +11,6 @@ public:
     static SolveStats solveAll(
         ISudokuSolver& solver,
         std::vector<Sudoku>& sudokus,
-        unsigned threadCount = std::thread::hardware_concurrency());
+        unsigned threadCount = std::thread::hardware_concurrency(),
+        LatencyReport* latency = nullptr);   // optional per-puzzle timing
 };
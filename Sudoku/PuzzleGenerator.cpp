@@ -0,0 +1,308 @@
+#include "PuzzleGenerator.h"
+#include "DatasetLoader.h"
+#include "LogicalSolver.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+/* ============================================================
+   BITMASK SEARCH
+   ============================================================ */
+namespace {
+
+struct SearchState
+{
+    uint8_t grid[81];
+    uint16_t used[UNIT_COUNT];   // digits placed per row / column / box
+
+    bool load(const uint8_t* g)
+    {
+        std::memcpy(grid, g, 81);
+        std::memset(used, 0, sizeof(used));
+        for (int i = 0; i < 81; ++i)
+            if (grid[i] != UNASSIGNED && !place(i, grid[i]))
+                return false;
+        return true;
+    }
+
+    uint16_t candidates(int i) const
+    {
+        const uint8_t* u = UNITS.ofCell[i];
+        return FULL_MASK & ~(used[u[0]] | used[u[1]] | used[u[2]]);
+    }
+
+    bool place(int i, uint8_t v)
+    {
+        const uint8_t* u = UNITS.ofCell[i];
+        uint16_t b = bit(v);
+        if ((used[u[0]] | used[u[1]] | used[u[2]]) & b)
+            return false;
+        used[u[0]] |= b;
+        used[u[1]] |= b;
+        used[u[2]] |= b;
+        grid[i] = v;
+        return true;
+    }
+
+    void unplace(int i)
+    {
+        const uint8_t* u = UNITS.ofCell[i];
+        uint16_t b = (uint16_t)~bit(grid[i]);
+        used[u[0]] &= b;
+        used[u[1]] &= b;
+        used[u[2]] &= b;
+        grid[i] = UNASSIGNED;
+    }
+
+    // MRV depth-first search; values in random order when rng is set.
+    // Leaves the first solution in grid when one is found with limit 1.
+    int search(int limit, std::mt19937_64* rng)
+    {
+        int best = -1, bestCount = 10;
+        for (int i = 0; i < 81; ++i)
+        {
+            if (grid[i] != UNASSIGNED) continue;
+            int n = std::popcount(candidates(i));
+            if (n < bestCount)
+            {
+                best = i;
+                bestCount = n;
+                if (n <= 1) break;
+            }
+        }
+        if (best < 0)
+            return 1;
+        if (bestCount == 0)
+            return 0;
+
+        uint8_t values[9];
+        int n = 0;
+        for (uint16_t m = candidates(best); m; m &= m - 1)
+            values[n++] = (uint8_t)(std::countr_zero(m) + 1);
+        if (rng)
+            std::shuffle(values, values + n, *rng);
+
+        int found = 0;
+        for (int k = 0; k < n && found < limit; ++k)
+        {
+            place(best, values[k]);
+            found += search(limit - found, rng);
+            if (found >= limit && limit == 1)
+                return found;   // keep the solution in grid
+            unplace(best);
+        }
+        return found;
+    }
+};
+
+}
+
+int PuzzleGenerator::countSolutions(const uint8_t* grid, int limit)
+{
+    SearchState s;
+    if (!s.load(grid))
+        return -1;
+    return s.search(limit, nullptr);
+}
+
+bool PuzzleGenerator::solveFirst(const uint8_t* grid, uint8_t* solution)
+{
+    SearchState s;
+    if (!s.load(grid) || s.search(1, nullptr) != 1)
+        return false;
+    std::memcpy(solution, s.grid, 81);
+    return true;
+}
+
+/* ============================================================
+   GENERATOR
+   ============================================================ */
+PuzzleGenerator::PuzzleGenerator(const GeneratorOptions& opts, uint64_t seed)
+    : options(opts), rng(seed)
+{
+}
+
+void PuzzleGenerator::randomSolution(uint8_t* grid)
+{
+    SearchState s;
+    uint8_t empty[81] = {};
+    s.load(empty);
+    s.search(1, &rng);
+    std::memcpy(grid, s.grid, 81);
+}
+
+bool PuzzleGenerator::reduce(uint8_t* puzzle)
+{
+    uint8_t order[81];
+    for (int i = 0; i < 81; ++i)
+        order[i] = (uint8_t)i;
+    std::shuffle(order, order + 81, rng);
+
+    int clues = 81;
+    SearchState s;
+    for (int k = 0; k < 81 && clues > options.targetClues; ++k)
+    {
+        int cell = order[k];
+        uint8_t v = puzzle[cell];
+        puzzle[cell] = UNASSIGNED;
+
+        // unique iff no solution puts another value in this cell
+        s.load(puzzle);
+        bool unique = true;
+        for (uint16_t m = s.candidates(cell) & ~bit(v); m && unique; m &= m - 1)
+        {
+            s.place(cell, (uint8_t)(std::countr_zero(m) + 1));
+            if (s.search(1, nullptr))
+            {
+                unique = false;
+                break;
+            }
+            s.unplace(cell);
+        }
+
+        if (unique)
+            --clues;
+        else
+            puzzle[cell] = v;
+    }
+    return clues <= options.targetClues;
+}
+
+bool PuzzleGenerator::matchesDifficulty(const uint8_t* puzzle)
+{
+    if (options.difficulty == GeneratorOptions::Difficulty::Any)
+        return true;
+
+    Sudoku s;
+    std::memcpy(s.rawGridMutable(), puzzle, 81);
+    // technique chain only: "search" = needs lookahead or the MRV fallback
+    LogicalOptions chainOnly;
+    chainOnly.lookaheadDepth = 0;
+    LogicalSolver solver(chainOnly);
+    SolveResult r = solver.solve(s);
+
+    if (options.difficulty == GeneratorOptions::Difficulty::Logical)
+        return r == SolveResult::SolvedByLogical;
+    return r == SolveResult::SolvedByBacktracking;
+}
+
+bool PuzzleGenerator::generate(Sudoku& out)
+{
+    uint8_t puzzle[81];
+    for (int attempt = 0; attempt < options.maxAttempts; ++attempt)
+    {
+        randomSolution(puzzle);
+        if (!reduce(puzzle) || !matchesDifficulty(puzzle))
+            continue;
+
+        std::memcpy(out.rawGridMutable(), puzzle, 81);
+        return true;
+    }
+    return false;
+}
+
+/* ============================================================
+   COMMAND
+   ============================================================ */
+int PuzzleGenerator::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        std::cout << "Usage: Sudoku generate [options]\n"
+            << "  --count N           puzzles to generate (default: 10000)\n"
+            << "  --clues N           clue count to reduce to (default: 26; below ~22 most grids get stuck)\n"
+            << "  --difficulty D      any | logical | search (default: any)\n"
+            << "  --threads N         worker threads (default: all cores)\n"
+            << "  --seed N            base seed, output is reproducible per seed/threads (default: 1)\n"
+            << "  --format raw|line   merged.txt (raw) or 81-char lines (default: raw)\n"
+            << "  --out DIR           dataset folder to write (default: Dataset/Generated)\n";
+        return 0;
+    }
+
+    GeneratorOptions options;
+    options.targetClues = (int)std::clamp(cmd.getInt("clues", options.targetClues), 17LL, 80LL);
+    std::string difficulty = cmd.get("difficulty", "any");
+    if (difficulty == "logical") options.difficulty = GeneratorOptions::Difficulty::Logical;
+    else if (difficulty == "search") options.difficulty = GeneratorOptions::Difficulty::Search;
+    else if (difficulty != "any")
+    {
+        std::cerr << "Unknown difficulty: " << difficulty << "\n";
+        return 2;
+    }
+
+    size_t count = (size_t)std::max(1LL, cmd.getInt("count", 10000));
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned threads = (unsigned)std::max(1LL, cmd.getInt("threads", hw ? hw : 1));
+    uint64_t seed = (uint64_t)cmd.getInt("seed", 1);
+    std::string format = cmd.get("format", "raw");
+    std::string outDir = cmd.get("out", "Dataset/Generated");
+
+    if (format != "raw" && format != "line")
+    {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 2;
+    }
+
+    // each thread owns a contiguous slice and its own generator
+    std::vector<Sudoku> puzzles(count);
+    std::vector<size_t> produced(threads, 0);
+    std::vector<std::thread> pool;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]()
+            {
+                size_t begin = count * t / threads;
+                size_t end = count * (t + 1) / threads;
+                PuzzleGenerator gen(options, seed * 0x9E3779B97F4A7C15ull + t);
+                size_t n = begin;
+                while (n < end && gen.generate(puzzles[n]))
+                    ++n;
+                produced[t] = n - begin;
+            });
+    }
+    for (auto& th : pool)
+        th.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    // drop the tail of slices that gave up
+    std::vector<Sudoku> out;
+    out.reserve(count);
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        size_t begin = count * t / threads;
+        out.insert(out.end(), puzzles.begin() + begin, puzzles.begin() + begin + produced[t]);
+    }
+
+    std::filesystem::create_directories(outDir);
+    if (format == "raw")
+        DatasetLoader::writeMerged(outDir, out);
+    else
+    {
+        std::ofstream file(outDir + "/generated.txt");
+        if (!file)
+        {
+            std::cerr << "Cannot write " << outDir << "/generated.txt\n";
+            return 1;
+        }
+        DatasetLoader::writeLineFormat(file, out);
+    }
+
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    std::cout << "[GENERATE] " << out.size() << " puzzles (" << options.targetClues
+        << " clues, " << difficulty << ") in " << sec << " s, "
+        << (sec > 0 ? (double)out.size() / sec : 0.0) << " puzzles/s on "
+        << threads << " threads -> " << outDir << "\n";
+    if (out.size() < count)
+        std::cout << "[WARN] " << count - out.size()
+            << " puzzles not generated: no grid met --clues/--difficulty within "
+            << options.maxAttempts << " attempts\n";
+    return out.empty() ? 1 : 0;
+}
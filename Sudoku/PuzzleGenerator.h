@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CommandLine.h"
+#include "Sudoku.h"
+
+struct GeneratorOptions
+{
+    // Logical: solved by the LogicalSolver technique chain without lookahead,
+    // Search: needs lookahead or the backtracking fallback
+    enum class Difficulty { Any, Logical, Search };
+
+    int targetClues = 26;          // puzzles stuck above this are discarded
+    Difficulty difficulty = Difficulty::Any;
+    int maxAttempts = 1000;        // grids tried per emitted puzzle before giving up
+};
+
+// Random complete grid -> remove clues in random order while the solution
+// stays unique. Uniqueness of removing (cell, v) is checked by asking the
+// bitmask search for any solution with a different value in that cell.
+class PuzzleGenerator
+{
+public:
+    PuzzleGenerator(const GeneratorOptions& options, uint64_t seed);
+
+    // false if no puzzle met the options within maxAttempts grids
+    bool generate(Sudoku& out);
+
+    // number of solutions, stops counting at 'limit'; -1 if the clues conflict
+    static int countSolutions(const uint8_t* grid, int limit);
+
+    // first solution in search order into 'solution'; false if there is none
+    static bool solveFirst(const uint8_t* grid, uint8_t* solution);
+
+    // "generate" command: multi-threaded, writes a dataset folder
+    static int runCommand(const CommandLine& cmd);
+
+private:
+    void randomSolution(uint8_t* grid);
+    bool reduce(uint8_t* puzzle);
+    bool matchesDifficulty(const uint8_t* puzzle);
+
+    GeneratorOptions options;
+    std::mt19937_64 rng;
+};
@@ -0,0 +1,363 @@
+#include "RegressionSuite.h"
+#include "AsyncSolver.h"
+#include "DatasetLoader.h"
+#include "LogicalSolverSIMD.h"
+#include "PuzzleGenerator.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+using Clock = std::chrono::steady_clock;
+
+/* ============================================================
+   CASES
+   ============================================================ */
+static void addCase(std::vector<RegressionCase>& cases, const Sudoku& s, const std::string& set, size_t index)
+{
+    RegressionCase c;
+    c.puzzle = s;
+    c.set = set;
+    c.index = index;
+    c.solutions = std::max(0, PuzzleGenerator::countSolutions(s.rawGrid(), 2));
+    if (c.solutions == 1)
+        PuzzleGenerator::solveFirst(s.rawGrid(), c.solution);
+    cases.push_back(c);
+}
+
+std::vector<RegressionCase> RegressionSuite::buildCases(const RegressionConfig& config)
+{
+    std::vector<RegressionCase> cases;
+
+    for (int d : config.datasets)
+    {
+        std::vector<Sudoku> ds = DatasetLoader::loadSingleDataset(
+            DatasetLoader::datasetFolder(config.datasetRoot, d), config.maxPerDataset);
+        for (size_t i = 0; i < ds.size(); ++i)
+            addCase(cases, ds[i], std::to_string(d), i);
+    }
+
+    // generated puzzles; every third one gets a wrong but non-conflicting
+    // clue (unsolvable) and every third one loses clues (usually several
+    // solutions), so the Unsolvable and non-unique paths are covered too
+    PuzzleGenerator gen(GeneratorOptions(), config.seed);
+    std::mt19937_64 rng(config.seed);
+    for (size_t i = 0; i < config.random; ++i)
+    {
+        Sudoku s;
+        if (!gen.generate(s))
+            break;
+
+        uint8_t solution[81];
+        PuzzleGenerator::solveFirst(s.rawGrid(), solution);
+        uint8_t* g = s.rawGridMutable();
+
+        if (i % 3 == 1)
+        {
+            for (int tries = 0; tries < 200; ++tries)
+            {
+                int cell = (int)(rng() % 81);
+                uint8_t v = (uint8_t)(rng() % 9 + 1);
+                if (g[cell] != UNASSIGNED || v == solution[cell])
+                    continue;
+                g[cell] = v;
+                if (s.isConsistent())
+                    break;
+                g[cell] = UNASSIGNED;
+            }
+        }
+        else if (i % 3 == 2)
+        {
+            for (int removed = 0, tries = 0; removed < 4 && tries < 200; ++tries)
+            {
+                int cell = (int)(rng() % 81);
+                if (g[cell] == UNASSIGNED)
+                    continue;
+                g[cell] = UNASSIGNED;
+                ++removed;
+            }
+        }
+        addCase(cases, s, "random", i);
+    }
+    return cases;
+}
+
+const char* RegressionSuite::checkAnswer(const RegressionCase& c, const Sudoku& out, SolveResult r,
+    bool assumesUnique)
+{
+    const uint8_t* in = c.puzzle.rawGrid();
+    const uint8_t* g = out.rawGrid();
+
+    // the grid of an Unsolvable answer is scratch (propagation may stop
+    // mid-contradiction), only the verdict counts
+    if (r == SolveResult::Unsolvable)
+    {
+        // uniqueness techniques may wrongly give up on multi-solution input
+        if (c.solutions == 0 || (assumesUnique && c.solutions > 1))
+            return nullptr;
+        return "reported unsolvable";
+    }
+
+    for (int i = 0; i < 81; ++i)
+        if (in[i] != UNASSIGNED && g[i] != in[i])
+            return "changed a given";
+    if (!out.isConsistent())
+        return "conflicting grid";
+
+    bool complete = std::find(g, g + 81, (uint8_t)UNASSIGNED) == g + 81;
+    switch (r)
+    {
+    case SolveResult::BudgetExceeded:
+        return nullptr;
+    case SolveResult::AlreadySolved:
+        return std::find(in, in + 81, (uint8_t)UNASSIGNED) == in + 81 ? nullptr : "reported already solved";
+    default:
+        if (!complete)
+            return "incomplete solution";
+        if (c.solutions == 1 && std::memcmp(g, c.solution, 81) != 0)
+            return "differs from the unique solution";
+        return nullptr;
+    }
+}
+
+/* ============================================================
+   BASELINE
+   ============================================================ */
+bool RegressionSuite::loadBaseline(const std::string& path, Baseline& out)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream ls(line);
+        std::string solver, set;
+        BaselineEntry entry;
+        if (!(ls >> solver >> set >> entry.ns))
+            continue;
+        if (!(ls >> entry.overBudget))
+            entry.overBudget = -1;
+        out[{ solver, set }] = entry;
+    }
+    return true;
+}
+
+bool RegressionSuite::saveBaseline(const std::string& path, const Baseline& baseline)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "# regress baseline: <solver> <set> <ns per puzzle> <over budget>\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& [key, entry] : baseline)
+    {
+        out << key.first << ' ' << key.second << ' ' << entry.ns;
+        if (entry.overBudget >= 0)
+            out << ' ' << entry.overBudget;
+        out << '\n';
+    }
+    return true;
+}
+
+/* ============================================================
+   COMMAND
+   ============================================================ */
+void RegressionSuite::printUsage(std::ostream& os)
+{
+    os << "Usage: Sudoku regress [options]\n"
+        << "  --solvers a,b       engines to check (default: all registered)\n"
+        << "  --datasets 0,1,5    dataset indices (default: all)\n"
+        << "  --dataset-root DIR  folder containing Dataset0..5 (default: Dataset)\n"
+        << "  --max N             puzzles per dataset (default: 100)\n"
+        << "  --random N          generated puzzles incl. unsolvable / multi-solution variants (default: 200)\n"
+        << "  --seed N            generator seed (default: 1)\n"
+        << "  --reps N            timed repetitions, best one counts (default: 5)\n"
+        << "  --node-budget N     per-puzzle search node budget (default: 2000000)\n"
+        << "  --baseline FILE     throughput and over-budget baseline (default: regress_baseline.txt)\n"
+        << "  --threshold X       allowed ns/puzzle growth, 0.15 = 15% (default: 0.15)\n"
+        << "  --update-baseline   write the measured numbers as the new baseline\n"
+        << "  --no-simd-diff      skip the scalar vs SIMD technique check\n";
+}
+
+int RegressionSuite::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    RegressionConfig config;
+    config.solvers = cmd.getList("solvers");
+    if (config.solvers.empty())
+        config.solvers = SolverRegistry::names();
+    for (long long d : cmd.getIntList("datasets"))
+        config.datasets.push_back((int)d);
+    if (!cmd.has("datasets"))
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            config.datasets.push_back(d);
+    config.datasetRoot = cmd.get("dataset-root", config.datasetRoot);
+    config.maxPerDataset = (size_t)std::max(0LL, cmd.getInt("max", (long long)config.maxPerDataset));
+    config.random = (size_t)std::max(0LL, cmd.getInt("random", (long long)config.random));
+    config.seed = (uint64_t)cmd.getInt("seed", (long long)config.seed);
+    config.repetitions = (int)std::max(1LL, cmd.getInt("reps", config.repetitions));
+    config.nodeBudget = (uint64_t)std::max(0LL, cmd.getInt("node-budget", (long long)config.nodeBudget));
+    config.baselinePath = cmd.get("baseline", config.baselinePath);
+    config.threshold = cmd.getDouble("threshold", config.threshold);
+    config.updateBaseline = cmd.has("update-baseline");
+    config.simdDiff = !cmd.has("no-simd-diff");
+
+    for (const std::string& name : config.solvers)
+        if (!SolverRegistry::create(name))
+        {
+            std::cerr << "Unknown solver: " << name << "\n";
+            return 2;
+        }
+
+    std::vector<RegressionCase> cases = buildCases(config);
+    std::vector<std::string> sets;
+    for (const RegressionCase& c : cases)
+        if (std::find(sets.begin(), sets.end(), c.set) == sets.end())
+            sets.push_back(c.set);
+    std::cout << "[REGRESS] " << cases.size() << " puzzles, " << config.solvers.size() << " engines\n";
+
+    Baseline baseline, measured;
+    bool haveBaseline = loadBaseline(config.baselinePath, baseline);
+    if (!haveBaseline && !config.updateBaseline)
+        std::cout << "[REGRESS] No baseline at " << config.baselinePath
+            << ", correctness only (use --update-baseline to create one)\n";
+
+    size_t wrong = 0, regressions = 0;
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (const std::string& name : config.solvers)
+    {
+        std::unique_ptr<ISudokuSolver> solver = SolverRegistry::create(name);
+        bool assumesUnique = name.find("unique") != std::string::npos;
+        std::cout << "\n=== " << name << " ===\n";
+
+        size_t engineWrong = 0;
+        for (const std::string& set : sets)
+        {
+            std::vector<const RegressionCase*> group;
+            for (const RegressionCase& c : cases)
+                if (c.set == set)
+                    group.push_back(&c);
+
+            double bestNs = 0.0;
+            size_t overBudget = 0;
+            for (int rep = 0; rep < config.repetitions; ++rep)
+            {
+                std::vector<Sudoku> work;
+                work.reserve(group.size());
+                for (const RegressionCase* c : group)
+                    work.push_back(c->puzzle);
+                std::vector<SolveResult> results(work.size());
+
+                SearchStats search;
+                Clock::time_point t0 = Clock::now();
+                for (size_t i = 0; i < work.size(); ++i)
+                    results[i] = solver->solveWithBudget(work[i], search,
+                        SolveBudget::of(config.nodeBudget, std::chrono::microseconds(0)));
+                Clock::time_point t1 = Clock::now();
+
+                double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+                if (rep == 0 || ns < bestNs)
+                    bestNs = ns;
+                if (rep > 0)
+                    continue;
+
+                // answers are checked on the first repetition only
+                for (size_t i = 0; i < work.size(); ++i)
+                {
+                    overBudget += results[i] == SolveResult::BudgetExceeded;
+                    const char* error = checkAnswer(*group[i], work[i], results[i], assumesUnique);
+                    if (!error)
+                        continue;
+                    if (++engineWrong <= 10)
+                        std::cout << "[WRONG] set " << set << " #" << group[i]->index << ": " << error
+                            << " (" << solveResultName(results[i]) << ", "
+                            << group[i]->solutions << (group[i]->solutions > 1 ? "+" : "") << " solutions)\n";
+                }
+            }
+
+            double perPuzzle = group.empty() ? 0.0 : bestNs / (double)group.size();
+            measured[{ name, set }] = { perPuzzle, (long long)overBudget };
+
+            std::cout << "  set " << std::setw(6) << set << "  n=" << std::setw(5) << group.size()
+                << "  ns/puzzle=" << std::setw(12) << perPuzzle;
+            if (overBudget)
+                std::cout << "  over_budget=" << overBudget;
+
+            auto it = baseline.find({ name, set });
+            if (it != baseline.end() && it->second.ns > 0)
+            {
+                double change = perPuzzle / it->second.ns - 1.0;
+                std::cout << "  baseline=" << it->second.ns << "  " << std::showpos << 100.0 * change
+                    << std::noshowpos << "%";
+                if (change > config.threshold)
+                {
+                    std::cout << "  REGRESSION";
+                    ++regressions;
+                }
+            }
+            if (it != baseline.end() && it->second.overBudget >= 0 && (long long)overBudget > it->second.overBudget)
+            {
+                std::cout << "  OVER BUDGET " << overBudget << " (baseline " << it->second.overBudget << ")";
+                ++regressions;
+            }
+            std::cout << "\n";
+        }
+        if (engineWrong > 10)
+            std::cout << "[WRONG] ... " << engineWrong - 10 << " more\n";
+        wrong += engineWrong;
+    }
+
+    // every technique of the SIMD engine must reach the scalar fixpoint;
+    // unsolvable cases are skipped, a contradiction has no defined fixpoint
+    size_t simdMismatches = 0;
+    if (config.simdDiff)
+    {
+        std::vector<Sudoku> puzzles;
+        puzzles.reserve(cases.size());
+        for (const RegressionCase& c : cases)
+            if (c.solutions > 0)
+                puzzles.push_back(c.puzzle);
+        std::cout << "\n";
+        simdMismatches = LogicalSolverSIMD::differentialCheck(puzzles, std::cout);
+    }
+
+    // front end: throwing completion callbacks
+    std::cout << "\n";
+    size_t asyncFailures = AsyncSolver::callbackCheck(std::cout);
+
+    if (config.updateBaseline)
+    {
+        // keep entries of engines / sets that were not part of this run
+        for (const auto& [key, entry] : measured)
+            baseline[key] = entry;
+        if (!saveBaseline(config.baselinePath, baseline))
+        {
+            std::cerr << "Cannot write " << config.baselinePath << "\n";
+            return 1;
+        }
+        std::cout << "\n[REGRESS] Baseline written to " << config.baselinePath << "\n";
+    }
+
+    bool pass = wrong == 0 && regressions == 0 && simdMismatches == 0 && asyncFailures == 0;
+    std::cout << "\n[REGRESS] " << (pass ? "PASS" : "FAIL") << ": " << wrong << " wrong answers, "
+        << simdMismatches << " SIMD mismatches, " << asyncFailures << " async failures, " << regressions << " regressions (threshold " << 100.0 * config.threshold << "%)\n";
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+
+// One puzzle of the suite with its independently computed ground truth
+// (bitmask search in PuzzleGenerator, not any of the engines under test).
+struct RegressionCase
+{
+    Sudoku puzzle;
+    std::string set;               // "0".."5" = dataset, "random" = generated
+    size_t index = 0;
+    int solutions = 0;             // 0, 1 or 2 (= more than one)
+    uint8_t solution[81] = {};     // valid when solutions == 1
+};
+
+struct RegressionConfig
+{
+    std::vector<std::string> solvers;       // empty = every registered engine
+    std::vector<int> datasets;              // empty = all
+    std::string datasetRoot = "Dataset";
+    size_t maxPerDataset = 100;
+    size_t random = 200;                    // generated puzzles (plus unsolvable / multi-solution variants)
+    uint64_t seed = 1;
+    int repetitions = 5;                    // timing = best repetition
+    uint64_t nodeBudget = 2000000;          // keeps plain backtracking bounded on hard sets
+    std::string baselinePath = "regress_baseline.txt";
+    double threshold = 0.15;                // fail when ns/puzzle grows by more than this
+    bool updateBaseline = false;
+    bool simdDiff = true;                   // scalar vs AVX2 technique check on the suite puzzles
+};
+
+// "regress" command: differential correctness of every engine against the
+// ground truth, the scalar vs SIMD technique check of LogicalSolverSIMD, the
+// AsyncSolver callback check and a throughput comparison with a stored
+// baseline. Exit code 1 when any engine returns a wrong answer, a SIMD
+// technique disagrees with its scalar version, the async check fails, or
+// throughput regresses. More puzzles over the node budget than in the
+// baseline count as a regression too: a slower search would otherwise
+// look faster by giving up earlier.
+struct BaselineEntry
+{
+    double ns = 0.0;              // per puzzle
+    long long overBudget = -1;    // -1 = not recorded (older baseline files)
+};
+
+class RegressionSuite
+{
+public:
+    // (solver, set) -> entry
+    using Baseline = std::map<std::pair<std::string, std::string>, BaselineEntry>;
+
+    static int runCommand(const CommandLine& cmd);
+    static void printUsage(std::ostream& os);
+
+    static std::vector<RegressionCase> buildCases(const RegressionConfig& config);
+
+    // nullptr if the answer is acceptable for this case
+    static const char* checkAnswer(const RegressionCase& c, const Sudoku& out, SolveResult r,
+        bool assumesUnique);
+
+    static bool loadBaseline(const std::string& path, Baseline& out);
+    static bool saveBaseline(const std::string& path, const Baseline& baseline);
+};
@@ -0,0 +1,353 @@
+#include "RouterSolver.h"
+#include "DatasetLoader.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+/* ============================================================
+   MODEL
+   ============================================================ */
+RouterModel RouterModel::defaults()
+{
+    // fitted with calibrate-router on Dataset0-5 (200 puzzles each)
+    RouterModel m;
+    m.engines = { "logical-simd", "mrv" };
+    m.weights = {
+        RouterFeatures{ 8.66473327, 0.0398278443, 0.000807007272, -0.0198199713, 0.00110657528, -0.0145954565 },
+        RouterFeatures{ 11.5240951, -0.248844378, 0.0686666199, 0.0457104518, 0.020194076, 0.0842686652 },
+    };
+    return m;
+}
+
+bool RouterModel::load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    RouterModel m;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream ls(line);
+        std::string name;
+        RouterFeatures w{};
+        ls >> name;
+        for (double& v : w)
+            ls >> v;
+        if (!ls)
+            return false;
+
+        m.engines.push_back(name);
+        m.weights.push_back(w);
+    }
+    if (m.engines.empty() || m.engines.size() > RouterSolver::MAX_ENGINES)
+        return false;
+
+    *this = m;
+    return true;
+}
+
+bool RouterModel::save(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "# RouterSolver cost model: ln(ns) = w . [1, empty, candidates, nakedSingles, hiddenSingles, bivalue]\n";
+    out << std::setprecision(9);
+    for (size_t e = 0; e < engines.size(); ++e)
+    {
+        out << engines[e];
+        for (double v : weights[e])
+            out << ' ' << v;
+        out << '\n';
+    }
+    return true;
+}
+
+double RouterModel::predictLog(size_t engine, const RouterFeatures& f) const
+{
+    double v = 0.0;
+    for (int i = 0; i < RF_COUNT; ++i)
+        v += weights[engine][i] * f[i];
+    return v;
+}
+
+/* ============================================================
+   SOLVER
+   ============================================================ */
+RouterSolver::RouterSolver(const RouterModel& m) : model(m)
+{
+    if (model.engines.empty() || model.engines.size() > MAX_ENGINES)
+        throw std::runtime_error("RouterSolver: 1.." + std::to_string(MAX_ENGINES) + " engines expected");
+
+    for (const std::string& name : model.engines)
+    {
+        std::unique_ptr<ISudokuSolver> e = SolverRegistry::create(name);
+        if (!e)
+            throw std::runtime_error("RouterSolver: unknown engine " + name);
+        engines.push_back(std::move(e));
+    }
+}
+
+RouterFeatures RouterSolver::extractFeatures(const Sudoku& sudoku)
+{
+    const uint8_t* g = sudoku.rawGrid();
+
+    // used digits per unit, then candidates = ~(row | col | box)
+    uint16_t used[UNIT_COUNT] = {};
+    for (int u = 0; u < UNIT_COUNT; ++u)
+        for (int k = 0; k < NUMBER_COUNT; ++k)
+        {
+            uint8_t v = g[UNITS.cells[u][k]];
+            if (v != UNASSIGNED)
+                used[u] |= bit(v);
+        }
+
+    uint16_t cand[NUMBER_COUNT * NUMBER_COUNT];
+    RouterFeatures f{};
+    f[RF_BIAS] = 1.0;
+
+    for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+    {
+        if (g[i] != UNASSIGNED)
+        {
+            cand[i] = 0;
+            continue;
+        }
+        const uint8_t* u = UNITS.ofCell[i];
+        cand[i] = FULL_MASK & ~(used[u[0]] | used[u[1]] | used[u[2]]);
+
+        int n = std::popcount(cand[i]);
+        f[RF_EMPTY_CELLS] += 1;
+        f[RF_CANDIDATES] += n;
+        if (n == 1) f[RF_NAKED_SINGLES] += 1;
+        if (n == 2) f[RF_BIVALUE] += 1;
+    }
+
+    for (int u = 0; u < UNIT_COUNT; ++u)
+    {
+        uint16_t once = 0, twice = 0;
+        for (int k = 0; k < NUMBER_COUNT; ++k)
+        {
+            uint16_t m = cand[UNITS.cells[u][k]];
+            twice |= once & m;
+            once |= m;
+        }
+        f[RF_HIDDEN_SINGLES] += std::popcount((uint16_t)(once & ~twice));
+    }
+    return f;
+}
+
+size_t RouterSolver::route(const Sudoku& sudoku) const
+{
+    if (engines.size() == 1)
+        return 0;
+
+    RouterFeatures f = extractFeatures(sudoku);
+    size_t best = 0;
+    double bestNs = model.predictLog(0, f);
+    for (size_t e = 1; e < engines.size(); ++e)
+    {
+        double ns = model.predictLog(e, f);
+        if (ns < bestNs)
+        {
+            bestNs = ns;
+            best = e;
+        }
+    }
+    return best;
+}
+
+SolveResult RouterSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult RouterSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult RouterSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+{
+    if (sudoku.isSolved())
+        return SolveResult::AlreadySolved;
+
+    size_t e = route(sudoku);
+    routed[e].fetch_add(1, std::memory_order_relaxed);
+    return engines[e]->solveWithBudget(sudoku, search, budget);
+}
+
+/* ============================================================
+   CALIBRATION
+   ============================================================ */
+// ridge least squares: (X^T X + lambda I) w = X^T y
+static RouterFeatures fitLinear(const std::vector<RouterFeatures>& x, const std::vector<double>& y)
+{
+    double a[RF_COUNT][RF_COUNT + 1] = {};
+    for (size_t n = 0; n < x.size(); ++n)
+        for (int i = 0; i < RF_COUNT; ++i)
+        {
+            for (int j = 0; j < RF_COUNT; ++j)
+                a[i][j] += x[n][i] * x[n][j];
+            a[i][RF_COUNT] += x[n][i] * y[n];
+        }
+
+    double trace = 0.0;
+    for (int i = 0; i < RF_COUNT; ++i)
+        trace += a[i][i];
+    for (int i = 0; i < RF_COUNT; ++i)
+        a[i][i] += 1e-9 * trace + 1e-12;
+
+    // Gauss-Jordan with partial pivoting
+    for (int c = 0; c < RF_COUNT; ++c)
+    {
+        int p = c;
+        for (int r = c + 1; r < RF_COUNT; ++r)
+            if (std::fabs(a[r][c]) > std::fabs(a[p][c]))
+                p = r;
+        std::swap(a[c], a[p]);
+
+        for (int r = 0; r < RF_COUNT; ++r)
+        {
+            if (r == c) continue;
+            double k = a[r][c] / a[c][c];
+            for (int j = c; j <= RF_COUNT; ++j)
+                a[r][j] -= k * a[c][j];
+        }
+    }
+
+    RouterFeatures w{};
+    for (int i = 0; i < RF_COUNT; ++i)
+        w[i] = a[i][RF_COUNT] / a[i][i];
+    return w;
+}
+
+int RouterSolver::calibrateCommand(const CommandLine& cmd)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (cmd.has("help"))
+    {
+        std::cout << "Usage: Sudoku calibrate-router [options]\n"
+            << "  --engines a,b       candidate engines (default: logical-simd,mrv)\n"
+            << "  --datasets 0,1,5    dataset indices (default: all)\n"
+            << "  --dataset-root DIR  (default: Dataset)\n"
+            << "  --max N             puzzles per dataset (default: 200)\n"
+            << "  --trials N          timings per puzzle, fastest kept (default: 2)\n"
+            << "  --out FILE          model file (default: " << DEFAULT_MODEL_PATH << ")\n";
+        return 0;
+    }
+
+    RouterModel model;
+    model.engines = cmd.getList("engines", "logical-simd,mrv");
+    std::vector<long long> ids = cmd.getIntList("datasets");
+    if (ids.empty())
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            ids.push_back(d);
+    std::string root = cmd.get("dataset-root", "Dataset");
+    size_t maxPer = (size_t)std::max(1LL, cmd.getInt("max", 200));
+    int trials = (int)std::max(1LL, cmd.getInt("trials", 2));
+    std::string outPath = cmd.get("out", DEFAULT_MODEL_PATH);
+
+    if (model.engines.empty() || model.engines.size() > MAX_ENGINES)
+    {
+        std::cerr << "1.." << MAX_ENGINES << " engines expected\n";
+        return 2;
+    }
+
+    std::vector<std::unique_ptr<ISudokuSolver>> engines;
+    for (const std::string& name : model.engines)
+    {
+        engines.push_back(SolverRegistry::create(name));
+        if (!engines.back())
+        {
+            std::cerr << "Unknown solver: " << name << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<Sudoku> puzzles;
+    for (long long d : ids)
+    {
+        std::vector<Sudoku> ds = DatasetLoader::loadSingleDataset(
+            DatasetLoader::datasetFolder(root, (int)d), maxPer);
+        puzzles.insert(puzzles.end(), ds.begin(), ds.end());
+    }
+
+    std::vector<RouterFeatures> features;
+    for (const Sudoku& s : puzzles)
+        features.push_back(extractFeatures(s));
+
+    // cost[e][p] = fastest of 'trials' solves
+    std::vector<std::vector<double>> cost(engines.size(), std::vector<double>(puzzles.size()));
+    for (size_t e = 0; e < engines.size(); ++e)
+    {
+        std::cout << "[CALIBRATE] timing " << model.engines[e] << std::endl;
+        for (size_t p = 0; p < puzzles.size(); ++p)
+        {
+            double best = 1e300;
+            for (int t = 0; t < trials; ++t)
+            {
+                Sudoku work = puzzles[p];
+                Clock::time_point t0 = Clock::now();
+                engines[e]->solve(work);
+                Clock::time_point t1 = Clock::now();
+                best = std::min(best, (double)std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(t1 - t0).count());
+            }
+            cost[e][p] = best;
+        }
+        std::vector<double> logCost(puzzles.size());
+        for (size_t p = 0; p < puzzles.size(); ++p)
+            logCost[p] = std::log(std::max(1.0, cost[e][p]));
+        model.weights.push_back(fitLinear(features, logCost));
+    }
+
+    // evaluate on the calibration set
+    RouterSolver router(model);
+    double routedNs = 0.0, oracleNs = 0.0;
+    for (size_t p = 0; p < puzzles.size(); ++p)
+    {
+        routedNs += cost[router.route(puzzles[p])][p];
+        double best = cost[0][p];
+        for (size_t e = 1; e < engines.size(); ++e)
+            best = std::min(best, cost[e][p]);
+        oracleNs += best;
+    }
+
+    std::cout << std::fixed << std::setprecision(0);
+    for (size_t e = 0; e < engines.size(); ++e)
+    {
+        double sum = 0.0;
+        for (double v : cost[e]) sum += v;
+        std::cout << "  " << std::left << std::setw(20) << model.engines[e] << std::right
+            << std::setw(10) << sum / (double)puzzles.size() << " ns/puzzle\n";
+    }
+    std::cout << "  " << std::left << std::setw(20) << "router" << std::right
+        << std::setw(10) << routedNs / (double)puzzles.size() << " ns/puzzle\n"
+        << "  " << std::left << std::setw(20) << "oracle" << std::right
+        << std::setw(10) << oracleNs / (double)puzzles.size() << " ns/puzzle\n";
+
+    if (!model.save(outPath))
+    {
+        std::cerr << "Cannot write " << outPath << "\n";
+        return 1;
+    }
+    std::cout << "[CALIBRATE] Model written to " << outPath << "\n";
+    return 0;
+}
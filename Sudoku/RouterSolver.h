@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ISudokuSolver.h"
+#include "CommandLine.h"
+
+// Cheap per-puzzle features used to pick an engine.
+enum {
+	RF_BIAS = 0,
+	RF_EMPTY_CELLS,
+	RF_CANDIDATES,      // sum of candidate counts over empty cells
+	RF_NAKED_SINGLES,   // cells with one candidate
+	RF_HIDDEN_SINGLES,  // unit/digit pairs with one position
+	RF_BIVALUE,         // cells with two candidates
+	RF_COUNT
+};
+
+using RouterFeatures = std::array<double, RF_COUNT>;
+
+// Log-linear cost model, one row per engine: predicted ns = exp(weights . features).
+// Fitting in log space keeps the few pathological search puzzles from
+// dominating the fit.
+struct RouterModel
+{
+	std::vector<std::string> engines;                // SolverRegistry names
+	std::vector<RouterFeatures> weights;
+
+	static RouterModel defaults();
+
+	// text format: "<engine> w0 w1 ... w5" per line, '#' comments
+	bool load(const std::string& path);
+	bool save(const std::string& path) const;
+
+	double predictLog(size_t engine, const RouterFeatures& f) const;
+	double predict(size_t engine, const RouterFeatures& f) const { return std::exp(predictLog(engine, f)); }
+};
+
+// Sends each puzzle to the engine the cost model expects to be fastest.
+class RouterSolver : public ISudokuSolver
+{
+public:
+	static constexpr size_t MAX_ENGINES = 8;
+	static constexpr const char* DEFAULT_MODEL_PATH = "router_model.txt";
+
+	explicit RouterSolver(const RouterModel& model = RouterModel::defaults());
+
+	SolveResult solve(Sudoku& sudoku) override;
+	SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+	SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
+	const char* getName() const override { return "Router Solver"; }
+
+	static RouterFeatures extractFeatures(const Sudoku& sudoku);
+	size_t route(const Sudoku& sudoku) const;
+
+	const RouterModel& getModel() const { return model; }
+	uint64_t routedCount(size_t engine) const { return routed[engine].load(std::memory_order_relaxed); }
+
+	// "calibrate-router" command: times every engine on every puzzle and
+	// fits the model by least squares
+	static int calibrateCommand(const CommandLine& cmd);
+
+private:
+	RouterModel model;
+	std::vector<std::unique_ptr<ISudokuSolver>> engines;
+	std::atomic<uint64_t> routed[MAX_ENGINES] = {};
+};
@@ -0,0 +1,734 @@
+#include "ShardRunner.h"
+#include "BudgetedSolver.h"
+#include "DatasetLoader.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/* ============================================================
+   SHARD SPEC
+   ============================================================ */
+bool ShardSpec::parse(const std::string& text, ShardSpec& out)
+{
+    size_t slash = text.find('/');
+    if (slash == std::string::npos)
+        return false;
+    try
+    {
+        long long i = std::stoll(text.substr(0, slash));
+        long long n = std::stoll(text.substr(slash + 1));
+        if (n < 1 || i < 0 || i >= n)
+            return false;
+        out.index = (unsigned)i;
+        out.count = (unsigned)n;
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+// FNV-1a over the grid: same puzzle, same shard, on every machine
+static uint64_t gridHash(const Sudoku& puzzle)
+{
+    uint64_t h = 1469598103934665603ULL;
+    const uint8_t* g = puzzle.rawGrid();
+    for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+    {
+        h ^= g[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::vector<uint32_t> ShardSpec::select(const std::vector<Sudoku>& puzzles) const
+{
+    std::vector<uint32_t> mine;
+    if (hash)
+    {
+        for (size_t i = 0; i < puzzles.size(); ++i)
+            if (gridHash(puzzles[i]) % count == index)
+                mine.push_back((uint32_t)i);
+    }
+    else
+    {
+        size_t begin = puzzles.size() * index / count;
+        size_t end = puzzles.size() * (index + 1) / count;
+        for (size_t i = begin; i < end; ++i)
+            mine.push_back((uint32_t)i);
+    }
+    return mine;
+}
+
+std::string ShardSpec::fileName(const std::string& prefix) const
+{
+    return prefix + "." + std::to_string(index) + "of" + std::to_string(count) + ".txt";
+}
+
+/* ============================================================
+   TOTALS
+   ============================================================ */
+void ShardTotals::merge(const ShardTotals& o)
+{
+    stats.merge(o.stats);
+    if (o.hasLogical)
+    {
+        hasLogical = true;
+        for (int t = 0; t < LS_COUNT; ++t)
+        {
+            logical.data[t][0] += o.logical.data[t][0];
+            logical.data[t][1] += o.logical.data[t][1];
+        }
+    }
+}
+
+void ShardTotals::print(std::ostream& os, const char* title) const
+{
+    os << "[" << title << "] puzzles=" << stats.total()
+        << " already=" << stats.alreadySolved
+        << " logical=" << stats.logical
+        << " backtracking=" << stats.backtracking
+        << " unsolvable=" << stats.unsolvable;
+    if (stats.budgetExceeded)
+        os << " budget_exceeded=" << stats.budgetExceeded;
+    os << "\n";
+    if (stats.search.nodes)
+        os << "  search nodes=" << stats.search.nodes
+            << " guesses=" << stats.search.guesses
+            << " backtracks=" << stats.search.backtracks
+            << " restarts=" << stats.search.restarts
+            << " maxDepth=" << stats.search.maxDepth << "\n";
+    if (hasLogical)
+        for (int t = 0; t < LS_COUNT; ++t)
+            if (logical.data[t][0])
+                os << "  " << LogicalSolver::techniqueName(t)
+                    << " hit=" << logical.data[t][0] << " effect=" << logical.data[t][1] << "\n";
+}
+
+// logical deltas first: the stats line commits a batch (see ShardLog)
+static void writeTotals(std::string& out, const ShardTotals& t)
+{
+    if (t.hasLogical)
+        for (int id = 0; id < LS_COUNT; ++id)
+            if (t.logical.data[id][0] || t.logical.data[id][1])
+                out += "logical " + std::to_string(id) + ' ' + std::to_string(t.logical.data[id][0]) + ' '
+                    + std::to_string(t.logical.data[id][1]) + '\n';
+
+    const SolveStats& s = t.stats;
+    std::ostringstream line;
+    line << "stats " << s.alreadySolved << ' ' << s.logical << ' ' << s.backtracking << ' '
+        << s.unsolvable << ' ' << s.budgetExceeded << ' ' << s.search.nodes << ' '
+        << s.search.guesses << ' ' << s.search.backtracks << ' ' << s.search.restarts << ' '
+        << s.search.maxDepth << '\n';
+    out += line.str();
+}
+
+static bool parseTotals(const std::string& tag, std::istringstream& ls, ShardTotals& into)
+{
+    if (tag == "stats")
+    {
+        SolveStats st;
+        if (!(ls >> st.alreadySolved >> st.logical >> st.backtracking >> st.unsolvable >> st.budgetExceeded
+            >> st.search.nodes >> st.search.guesses >> st.search.backtracks >> st.search.restarts
+            >> st.search.maxDepth))
+            return false;
+        into.stats.merge(st);
+        return true;
+    }
+    if (tag == "logical")
+    {
+        int id;
+        uint32_t hit, effect;
+        if (!(ls >> id >> hit >> effect) || id < 0 || id >= LS_COUNT)
+            return false;
+        into.logical.data[id][0] += hit;
+        into.logical.data[id][1] += effect;
+        into.hasLogical = true;
+        return true;
+    }
+    return false;
+}
+
+/* ============================================================
+   CHECKPOINT LOG
+   ============================================================ */
+static void syncFile(FILE* f)
+{
+    std::fflush(f);
+#ifdef _WIN32
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+ShardLog::ShardLog(size_t syncRecords, std::chrono::milliseconds syncInterval)
+    : syncRecords(syncRecords), syncInterval(syncInterval), lastSync(Clock::now())
+{
+}
+
+ShardLog::~ShardLog()
+{
+    if (writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+    if (file)
+        std::fclose(file);
+}
+
+void ShardLog::startWriter()
+{
+    writer = std::thread([this]() { writerLoop(); });
+}
+
+// takes every closed batch at once: one write and one fsync however many
+// batches the workers closed while the last sync ran
+void ShardLog::writerLoop()
+{
+    std::string out;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this]() { return stopping || !ready.empty(); });
+            if (ready.empty())
+                return;   // stopping, nothing left
+            out.swap(ready);
+        }
+        std::fwrite(out.data(), 1, out.size(), file);
+        syncFile(file);
+        ++syncs;
+        out.clear();
+    }
+}
+
+bool ShardLog::create(const std::string& path, const std::string& header)
+{
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    std::fputs((header + "\n").c_str(), file);
+    syncFile(file);
+    startWriter();
+    return true;
+}
+
+ShardLog::Resume ShardLog::resume(const std::string& path, const std::string& header, size_t total,
+    std::vector<uint8_t>& done, ShardTotals& prior, bool& complete, std::string& found)
+{
+    std::error_code exists;
+    if (!std::filesystem::exists(path, exists))
+        return Resume::Missing;
+
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    if (!in)
+        return Resume::Failed;
+    if (!std::getline(in, line) || line != header)
+    {
+        found = line;
+        return Resume::Mismatch;
+    }
+
+    // records become done only when the stats line of their batch made it
+    // to disk; anything after the last one is cut off and solved again
+    uint64_t offset = line.size() + 1, committed = offset;
+    std::vector<uint32_t> batch;
+    ShardTotals batchTotals;
+    while (std::getline(in, line))
+    {
+        if (in.eof())
+            break;   // no newline: torn write
+        offset += line.size() + 1;
+
+        std::istringstream ls(line);
+        std::string tag;
+        ls >> tag;
+        if (tag == "r")
+        {
+            size_t index;
+            if (!(ls >> index) || index >= total)
+                break;
+            batch.push_back((uint32_t)index);
+        }
+        else if (tag == "logical")
+        {
+            if (!parseTotals(tag, ls, batchTotals))
+                break;
+        }
+        else if (tag == "stats")
+        {
+            if (!parseTotals(tag, ls, batchTotals))
+                break;
+            for (uint32_t i : batch)
+                done[i] = 1;
+            prior.merge(batchTotals);
+            batch.clear();
+            batchTotals = ShardTotals();
+            committed = offset;
+        }
+        else if (tag == "end")
+        {
+            complete = true;
+            committed = offset;
+            break;
+        }
+        else
+            break;
+    }
+    in.close();
+
+    std::error_code ec;
+    std::filesystem::resize_file(path, committed, ec);
+    if (ec)
+        return Resume::Failed;
+    file = std::fopen(path.c_str(), "ab");
+    if (!file)
+        return Resume::Failed;
+    startWriter();
+    return Resume::Resumed;
+}
+
+void ShardLog::add(const std::string& records, size_t count, const ShardTotals& delta)
+{
+    Clock::time_point t0 = Clock::now();
+    std::lock_guard<std::mutex> guard(lock);
+    pending += records;
+    pendingRecords += count;
+    pendingTotals.merge(delta);
+    if (pendingRecords >= syncRecords || t0 - lastSync >= syncInterval)
+        commitLocked();
+    busy += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+}
+
+// closes the pending batch and hands it to the writer
+void ShardLog::commitLocked()
+{
+    if (!pendingRecords)
+        return;
+    writeTotals(pending, pendingTotals);
+    ready += pending;
+
+    pending.clear();
+    pendingRecords = 0;
+    pendingTotals = ShardTotals();
+    lastSync = Clock::now();
+    wake.notify_one();
+}
+
+bool ShardLog::finish()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        commitLocked();
+        stopping = true;
+    }
+    wake.notify_one();
+    if (writer.joinable())
+        writer.join();   // drains 'ready' first
+
+    std::fputs("end\n", file);
+    syncFile(file);
+    return !std::ferror(file);
+}
+
+/* ============================================================
+   RUN
+   ============================================================ */
+std::vector<Sudoku> ShardRunner::loadInput(const CommandLine& cmd)
+{
+    std::vector<Sudoku> puzzles;
+    if (cmd.has("input"))
+    {
+        std::ifstream in(cmd.get("input"));
+        if (!in || !DatasetLoader::readLineFormat(in, puzzles))
+            throw std::runtime_error("Cannot read " + cmd.get("input") + " (line format expected)");
+        return puzzles;
+    }
+
+    std::vector<long long> ids = cmd.getIntList("datasets");
+    if (ids.empty())
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            ids.push_back(d);
+    size_t maxPer = cmd.has("max") ? (size_t)std::max(1LL, cmd.getInt("max", 1)) : SIZE_MAX;
+    for (long long d : ids)
+    {
+        std::vector<Sudoku> ds = DatasetLoader::loadSingleDataset(
+            DatasetLoader::datasetFolder(cmd.get("dataset-root", "Dataset"), (int)d), maxPer);
+        puzzles.insert(puzzles.end(), ds.begin(), ds.end());
+    }
+    return puzzles;
+}
+
+int ShardRunner::run(const CommandLine& cmd)
+{
+    ShardSpec spec;
+    if (!ShardSpec::parse(cmd.get("shard", "0/1"), spec))
+    {
+        std::cerr << "--shard expects i/N with 0 <= i < N\n";
+        return 2;
+    }
+    std::string split = cmd.get("split", "range");
+    if (split != "range" && split != "hash")
+    {
+        std::cerr << "--split expects range or hash\n";
+        return 2;
+    }
+    spec.hash = split == "hash";
+
+    std::string solverName = cmd.get("solver", "logical-simd");
+    if (!SolverRegistry::create(solverName))
+    {
+        std::cerr << "Unknown solver: " << solverName << "\n";
+        return 2;
+    }
+
+    std::vector<Sudoku> puzzles = loadInput(cmd);
+    const size_t total = puzzles.size();
+
+    std::vector<uint32_t> mine = spec.select(puzzles);
+
+    // everything that changes the results: a checkpoint or shard file from
+    // another input order, engine or budget must not be resumed or merged
+    uint64_t fingerprint = 1469598103934665603ULL;
+    for (const Sudoku& p : puzzles)
+    {
+        fingerprint ^= gridHash(p);
+        fingerprint *= 1099511628211ULL;
+    }
+    BudgetOptions budget = BudgetOptions::fromCommandLine(cmd);
+    std::string escalate = budget.limited() ? cmd.get("escalate") : "";
+
+    std::string path = spec.fileName(cmd.get("out", "shard"));
+    std::ostringstream header;
+    header << "# sudoku-shard " << spec.index << ' ' << spec.count << ' ' << split << ' '
+        << total << ' ' << std::hex << std::setw(16) << std::setfill('0') << fingerprint << std::dec
+        << ' ' << solverName << ' ' << budget.maxNodes << ' ' << budget.timeLimit.count()
+        << ' ' << (escalate.empty() ? "-" : escalate);
+
+    ShardLog log((size_t)std::max(1LL, cmd.getInt("checkpoint-every", 4096)),
+        std::chrono::milliseconds(std::max(0LL, cmd.getInt("checkpoint-ms", 1000))));
+
+    // resume: only the puzzles without a committed record are scheduled
+    ShardTotals totals;
+    size_t skipped = 0;
+    if (cmd.has("resume"))
+    {
+        std::vector<uint8_t> done(total, 0);
+        bool complete = false;
+        std::string found;
+        ShardLog::Resume state = log.resume(path, header.str(), total, done, totals, complete, found);
+        if (state == ShardLog::Resume::Mismatch)
+        {
+            // other solver, budget, split, input or shard: never overwrite that checkpoint
+            std::cerr << "[SHARD] " << path << " was written by another run\n"
+                << "  file: " << found << "\n"
+                << "  this: " << header.str() << "\n"
+                << "Remove it or drop --resume to start over.\n";
+            return 2;
+        }
+        if (state == ShardLog::Resume::Failed)
+        {
+            std::cerr << "Cannot resume " << path << "\n";
+            return 1;
+        }
+        if (state == ShardLog::Resume::Resumed)
+        {
+            if (complete)
+            {
+                std::cout << "[SHARD] " << path << " is already complete\n";
+                totals.print(std::cout, "SHARD");
+                return 0;
+            }
+            size_t before = mine.size();
+            mine.erase(std::remove_if(mine.begin(), mine.end(), [&](uint32_t i) { return done[i] != 0; }), mine.end());
+            skipped = before - mine.size();
+        }
+        else if (!log.create(path, header.str()))
+        {
+            std::cerr << "Cannot write " << path << "\n";
+            return 1;
+        }
+    }
+    else if (!log.create(path, header.str()))
+    {
+        std::cerr << "Cannot write " << path << "\n";
+        return 1;
+    }
+
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned threads = (unsigned)std::max(1LL, cmd.getInt("threads", hw));
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max<size_t>(1, mine.size())));
+
+    // one engine per thread so the LogicalStats counters are not shared
+    std::vector<ShardTotals> perThread(threads);
+    std::atomic<size_t> next{ 0 };
+    const size_t CHUNK = 64;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+
+    auto worker = [&](unsigned t) {
+        // look for the technique counters before a budget wrapper hides the engine
+        std::unique_ptr<ISudokuSolver> engine = SolverRegistry::create(solverName);
+        LogicalSolver* logical = dynamic_cast<LogicalSolver*>(engine.get());
+        std::unique_ptr<ISudokuSolver> solver = BudgetedSolver::wrap(std::move(engine), cmd);
+        LogicalStats seen{};
+        std::string records, line(NUMBER_COUNT * NUMBER_COUNT, '0');
+
+        while (true)
+        {
+            size_t begin = next.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (begin >= mine.size())
+                break;
+            size_t end = std::min(mine.size(), begin + CHUNK);
+
+            ShardTotals delta;
+            records.clear();
+            for (size_t k = begin; k < end; ++k)
+            {
+                Sudoku& s = puzzles[mine[k]];
+                SolveResult r = solver->solveWithStats(s, delta.stats.search);
+                delta.stats.record(r);
+
+                const uint8_t* g = s.rawGrid();
+                for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+                    line[i] = (char)('0' + g[i]);
+                records += "r " + std::to_string(mine[k]) + ' ' + std::to_string((int)r) + ' ' + line + '\n';
+            }
+            if (logical)
+            {
+                const LogicalStats& now = logical->getLogicalStats();
+                for (int id = 0; id < LS_COUNT; ++id)
+                    for (int m = 0; m < 2; ++m)
+                        delta.logical.data[id][m] = now.data[id][m] - seen.data[id][m];
+                seen = now;
+                delta.hasLogical = true;
+            }
+            log.add(records, end - begin, delta);
+            perThread[t].merge(delta);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+        pool.emplace_back(worker, t);
+    for (std::thread& th : pool)
+        th.join();
+
+    if (!log.finish())
+    {
+        std::cerr << "Cannot write " << path << "\n";
+        return 1;
+    }
+    uint64_t elapsedNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+    for (const ShardTotals& t : perThread)
+        totals.merge(t);
+
+    std::cout << "[SHARD] " << spec.index << "/" << spec.count << " (" << split << "): "
+        << mine.size() << " of " << total << " puzzles in " << (double)elapsedNs / 1e6 << " ms on "
+        << threads << " threads -> " << path << "\n";
+    if (skipped)
+        std::cout << "[SHARD] resumed: " << skipped << " puzzles already in the log\n";
+    std::cout << "[SHARD] checkpoints: " << log.syncCount() << " fsyncs, "
+        << 100.0 * (double)log.busyNs() / ((double)elapsedNs * threads + 1.0) << "% of worker time\n";
+    totals.print(std::cout, "SHARD");
+    return 0;
+}
+
+/* ============================================================
+   MERGE
+   ============================================================ */
+int ShardRunner::merge(const CommandLine& cmd)
+{
+    std::string prefix = cmd.get("out", "shard");
+    unsigned count = (unsigned)std::max(1LL, cmd.getInt("shards", 0));
+    if (!cmd.has("shards"))
+    {
+        std::cerr << "--shards N required\n";
+        return 2;
+    }
+
+    std::vector<Sudoku> solved;
+    std::vector<int8_t> result;   // -1 = missing
+    size_t total = 0;
+    std::string firstRun;
+    ShardTotals totals;
+    int errors = 0;
+
+    for (unsigned s = 0; s < count; ++s)
+    {
+        ShardSpec spec;
+        spec.index = s;
+        spec.count = count;
+        std::string path = spec.fileName(prefix);
+        std::ifstream in(path);
+        if (!in)
+        {
+            std::cerr << "[MERGE] missing " << path << "\n";
+            ++errors;
+            continue;
+        }
+
+        // header: shard index and count, then the run (split, input, engine,
+        // budget) that every shard file has to share
+        std::string line, tag, run;
+        unsigned fi = 0, fn = 0;
+        size_t ft = 0;
+        std::istringstream hs;
+        if (std::getline(in, line))
+            hs.str(line);
+        if (!(hs >> tag >> tag >> fi >> fn) || !std::getline(hs >> std::ws, run)
+            || !(std::istringstream(run) >> tag >> ft) || fi != s || fn != count)
+        {
+            std::cerr << "[MERGE] bad header in " << path << "\n";
+            ++errors;
+            continue;
+        }
+        if (result.empty())
+        {
+            firstRun = run;
+            total = ft;
+            solved.resize(total);
+            result.assign(total, -1);
+        }
+        else if (run != firstRun)
+        {
+            std::cerr << "[MERGE] " << path << " comes from another run (split, input, solver or budget)\n"
+                << "  file:  " << run << "\n"
+                << "  first: " << firstRun << "\n";
+            ++errors;
+            continue;
+        }
+
+        ShardTotals fileTotals;
+        bool ended = false;
+        size_t records = 0;
+        while (std::getline(in, line))
+        {
+            std::istringstream ls(line);
+            ls >> tag;
+            if (tag == "r")
+            {
+                size_t index;
+                int code;
+                std::string grid;
+                if (!(ls >> index >> code >> grid) || index >= total || grid.size() != 81)
+                {
+                    std::cerr << "[MERGE] bad record in " << path << ": " << line << "\n";
+                    ++errors;
+                    continue;
+                }
+                if (result[index] >= 0)
+                {
+                    std::cerr << "[MERGE] puzzle " << index << " appears twice (" << path << ")\n";
+                    ++errors;
+                    continue;
+                }
+                uint8_t* g = solved[index].rawGridMutable();
+                for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+                    g[i] = (uint8_t)(grid[i] - '0');
+                result[index] = (int8_t)code;
+                ++records;
+            }
+            else if (tag == "stats" || tag == "logical")
+            {
+                if (!parseTotals(tag, ls, fileTotals))
+                {
+                    std::cerr << "[MERGE] bad line in " << path << ": " << line << "\n";
+                    ++errors;
+                }
+            }
+            else if (tag == "end")
+                ended = true;
+        }
+        if (!ended)
+        {
+            std::cerr << "[MERGE] " << path << " is incomplete (no end marker)\n";
+            ++errors;
+        }
+        totals.merge(fileTotals);
+        std::cout << "[MERGE] " << path << ": " << records << " puzzles\n";
+    }
+
+    size_t missing = (size_t)std::count(result.begin(), result.end(), (int8_t)-1);
+    if (missing)
+    {
+        std::cerr << "[MERGE] " << missing << " of " << total << " puzzles missing\n";
+        ++errors;
+    }
+
+    if (cmd.has("merged"))
+    {
+        std::ofstream out(cmd.get("merged"));
+        DatasetLoader::writeLineFormat(out, solved);
+        if (!out)
+        {
+            std::cerr << "Cannot write " << cmd.get("merged") << "\n";
+            return 1;
+        }
+        std::cout << "[MERGE] " << total << " grids in input order -> " << cmd.get("merged") << "\n";
+    }
+
+    totals.print(std::cout, "MERGE");
+    return errors ? 1 : 0;
+}
+
+int ShardRunner::runCommand(const CommandLine& cmd)
+{
+    const std::vector<std::string>& args = cmd.positional();
+    std::string action = args.size() > 1 ? args[1] : "";
+
+    if (cmd.has("help") || (action != "run" && action != "merge"))
+    {
+        std::cout << "Usage: Sudoku shard run --shard i/N [options]\n"
+            << "       Sudoku shard merge --shards N [options]\n"
+            << "run:\n"
+            << "  --shard i/N         this process solves part i of N (default: 0/1)\n"
+            << "  --split range|hash  index ranges or grid hash (default: range)\n"
+            << "  --input FILE        puzzles in line format (default: the datasets)\n"
+            << "  --datasets 0,1,5    dataset indices (default: all)\n"
+            << "  --dataset-root DIR  (default: Dataset)\n"
+            << "  --max N             puzzles per dataset (default: all)\n"
+            << "  --solver NAME       engine (default: logical-simd)\n"
+            << "  --threads N         solver threads (default: all cores)\n"
+            << BudgetedSolver::usage()
+            << "  --out PREFIX        result file PREFIX.<i>of<N>.txt (default: shard)\n"
+            << "  --resume            keep the committed records of an interrupted run\n"
+            << "                      and solve only the rest; exits with 2 if the file\n"
+            << "                      belongs to another solver / budget / split / input\n"
+            << "  --checkpoint-every N  records per fsync batch (default: 4096)\n"
+            << "  --checkpoint-ms N   max time between fsyncs (default: 1000)\n"
+            << "merge:\n"
+            << "  --shards N          number of shard files\n"
+            << "  --out PREFIX        as for run (default: shard)\n"
+            << "  --merged FILE       solved grids in input order (line format)\n";
+        return cmd.has("help") ? 0 : 2;
+    }
+
+    return action == "run" ? run(cmd) : merge(cmd);
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+#include "LogicalSolver.h"
+
+// Sharded batch mode for corpora that do not fit one process: every process
+// solves the part of the input selected by --shard i/N and writes its own
+// result file; "shard merge" rebuilds the output in input order and sums the
+// statistics. Processes share nothing but the input file, so they can run
+// on one machine or many.
+//
+// Split modes: "range" (contiguous index ranges, cache friendly) or "hash"
+// (FNV-1a of the grid, spreads sorted-by-difficulty inputs evenly).
+//
+// Shard file (text, append-only; it doubles as the checkpoint):
+//   # sudoku-shard <i> <N> <split> <total> <input> <solver> <node-budget>
+//     <time-budget-us> <escalate>
+// (<input>: FNV-1a over the grid hashes in input order, <escalate>: '-'
+// for none). Resume and merge require everything after <N> to match.
+// then one batch per checkpoint:
+//   r <index> <SolveResult code> <81 digits>   one per solved puzzle
+//   logical <technique> <hit> <effect>          LogicalSolver engines only
+//   stats <already> <logical> <backtracking> <unsolvable> <budget>
+//         <nodes> <guesses> <backtracks> <restarts> <maxDepth>
+// and "end" once the shard is complete. The stats line commits its batch:
+// --resume keeps committed batches, cuts off the rest and solves only the
+// missing puzzles. Merge sums every stats / logical line and requires "end".
+struct ShardSpec
+{
+    unsigned index = 0;
+    unsigned count = 1;
+    bool hash = false;
+
+    // "i/N", false if malformed or i >= N
+    static bool parse(const std::string& text, ShardSpec& out);
+
+    // indices of the puzzles of this shard, in input order
+    std::vector<uint32_t> select(const std::vector<Sudoku>& puzzles) const;
+    std::string fileName(const std::string& prefix) const;   // prefix.<i>of<N>.txt
+};
+
+struct ShardTotals
+{
+    SolveStats stats;
+    LogicalStats logical;
+    bool hasLogical = false;
+
+    void merge(const ShardTotals& o);
+    void print(std::ostream& os, const char* title) const;
+};
+
+// Append-only result log with batched fsync: workers hand in finished
+// chunks, a batch is closed once it holds syncRecords records or
+// syncInterval has passed. Closed batches are written and synced by a
+// writer thread, so workers never wait for the disk.
+class ShardLog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ShardLog(size_t syncRecords, std::chrono::milliseconds syncInterval);
+    ~ShardLog();
+    ShardLog(const ShardLog&) = delete;
+    ShardLog& operator=(const ShardLog&) = delete;
+
+    // truncates or creates the file and writes the header
+    bool create(const std::string& path, const std::string& header);
+
+    enum class Resume { Resumed, Missing, Mismatch, Failed };
+
+    // Reopens a log with the same header for appending: marks committed
+    // records in 'done', adds their totals to 'prior' and cuts off the
+    // uncommitted tail. A log with another header is left untouched and its
+    // first line returned in 'found'.
+    Resume resume(const std::string& path, const std::string& header, size_t total,
+        std::vector<uint8_t>& done, ShardTotals& prior, bool& complete, std::string& found);
+
+    // thread-safe
+    void add(const std::string& records, size_t count, const ShardTotals& delta);
+    bool finish();   // commits the rest and writes "end"
+
+    uint64_t syncCount() const { return syncs; }
+    uint64_t busyNs() const { return busy; }   // summed time of workers inside add()
+
+private:
+    void commitLocked();
+    void startWriter();
+    void writerLoop();
+
+    std::mutex lock;             // pending*, ready, stopping
+    std::condition_variable wake;
+    std::thread writer;
+    bool stopping = false;
+    std::string ready;           // closed batches the writer has not taken yet
+    FILE* file = nullptr;        // writer thread only while it runs
+    size_t syncRecords;
+    std::chrono::milliseconds syncInterval;
+    Clock::time_point lastSync;
+
+    std::string pending;
+    size_t pendingRecords = 0;
+    ShardTotals pendingTotals;
+    std::atomic<uint64_t> syncs{ 0 };
+    uint64_t busy = 0;
+};
+
+class ShardRunner
+{
+public:
+    // "shard run" / "shard merge"
+    static int runCommand(const CommandLine& cmd);
+
+    // input of "shard run": --input FILE (line format) or --datasets
+    static std::vector<Sudoku> loadInput(const CommandLine& cmd);
+
+    static int run(const CommandLine& cmd);
+    static int merge(const CommandLine& cmd);
+};
@@ -0,0 +1,164 @@
+#include "SolutionCache.h"
+
+#include <algorithm>
+
+/* ============================================================
+   CACHE
+   ============================================================ */
+SolutionCache::SolutionCache(size_t capacity, size_t shardCount)
+    : shards(std::max<size_t>(1, shardCount)),
+    shardCapacity(std::max<size_t>(1, capacity / std::max<size_t>(1, shardCount)))
+{
+}
+
+bool SolutionCache::lookup(const PuzzleKey& puzzle, Entry& out)
+{
+    Shard& s = shardOf(puzzle);
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto it = s.map.find(puzzle);
+        if (it != s.map.end())
+        {
+            s.lru.splice(s.lru.begin(), s.lru, it->second);
+            out = it->second->second;
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void SolutionCache::insert(const PuzzleKey& puzzle, const Entry& entry)
+{
+    Shard& s = shardOf(puzzle);
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    auto it = s.map.find(puzzle);
+    if (it != s.map.end())
+    {
+        it->second->second = entry;
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+    }
+
+    s.lru.emplace_front(puzzle, entry);
+    s.map.emplace(puzzle, s.lru.begin());
+
+    if (s.lru.size() > shardCapacity)
+    {
+        s.map.erase(s.lru.back().first);
+        s.lru.pop_back();
+    }
+}
+
+size_t SolutionCache::size() const
+{
+    size_t n = 0;
+    for (const Shard& s : shards)
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        n += s.map.size();
+    }
+    return n;
+}
+
+/* ============================================================
+   CACHED SOLVER
+   ============================================================ */
+CachedSolver::CachedSolver(std::unique_ptr<ISudokuSolver> innerSolver,
+    std::shared_ptr<SolutionCache> sharedCache)
+    : inner(std::move(innerSolver)), cache(std::move(sharedCache))
+{
+    name = std::string("Cached ") + inner->getName();
+}
+
+SolveResult CachedSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult CachedSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult CachedSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+{
+    if (sudoku.isSolved())
+        return SolveResult::AlreadySolved;
+
+    CanonicalForm form;
+    Canonicalizer::canonicalize(sudoku, form);
+    return solveCanonical(sudoku, form, search, budget);
+}
+
+SolveResult CachedSolver::solveCanonical(Sudoku& sudoku, const CanonicalForm& form,
+    SearchStats& search, const SolveBudget& budget)
+{
+    PuzzleKey key = form.key();
+
+    SolutionCache::Entry entry;
+    if (cache->lookup(key, entry))
+    {
+        if (entry.result == SolveResult::Unsolvable)
+            return entry.result;
+
+        uint8_t canonical[81];
+        entry.solution.unpack(canonical);
+        Canonicalizer::toOriginal(form, canonical, sudoku.rawGridMutable());
+        return entry.result;
+    }
+
+    SolveResult r = inner->solveWithBudget(sudoku, search, budget);
+    if (r == SolveResult::BudgetExceeded)
+        return r;   // nothing to cache
+
+    uint8_t canonical[81] = {};
+    if (r != SolveResult::Unsolvable)
+        Canonicalizer::toCanonical(form, sudoku.rawGrid(), canonical);
+    cache->insert(key, { PuzzleKey::pack(canonical), r });
+    return r;
+}
+
+SolveStats CachedSolver::solveAll(std::vector<Sudoku>& sudokus)
+{
+    SolveStats stats;
+    std::vector<CanonicalForm> forms(sudokus.size());
+    std::vector<SolveResult> results(sudokus.size(), SolveResult::AlreadySolved);
+    std::unordered_map<PuzzleKey, size_t, PuzzleKeyHash> first;
+    first.reserve(sudokus.size());
+
+    for (size_t i = 0; i < sudokus.size(); ++i)
+    {
+        Sudoku& s = sudokus[i];
+        if (s.isSolved())
+        {
+            stats.record(results[i]);
+            continue;
+        }
+
+        Canonicalizer::canonicalize(s, forms[i]);
+        auto [it, inserted] = first.emplace(forms[i].key(), i);
+        if (inserted)
+        {
+            results[i] = solveCanonical(s, forms[i], stats.search, SolveBudget());
+            stats.record(results[i]);
+            continue;
+        }
+
+        // duplicate of an earlier puzzle in this batch: map its solution
+        const Sudoku& rep = sudokus[it->second];
+        results[i] = results[it->second];
+        folded.fetch_add(1, std::memory_order_relaxed);
+        stats.record(results[i]);
+        if (results[i] == SolveResult::Unsolvable || results[i] == SolveResult::BudgetExceeded)
+            continue;
+
+        uint8_t canonical[81];
+        Canonicalizer::toCanonical(forms[it->second], rep.rawGrid(), canonical);
+        Canonicalizer::toOriginal(forms[i], canonical, s.rawGridMutable());
+    }
+    return stats;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Canonical.h"
+#include "ISudokuSolver.h"
+
+// Sharded LRU map: canonical puzzle -> canonical solution. Each shard has
+// its own mutex, so concurrent solvers only contend on the same shard.
+class SolutionCache
+{
+public:
+    struct Entry
+    {
+        PuzzleKey solution;
+        SolveResult result;
+    };
+
+    explicit SolutionCache(size_t capacity = 1 << 20, size_t shardCount = 64);
+
+    bool lookup(const PuzzleKey& puzzle, Entry& out);
+    void insert(const PuzzleKey& puzzle, const Entry& entry);
+
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+    size_t size() const;
+
+private:
+    struct Shard
+    {
+        using Item = std::pair<PuzzleKey, Entry>;
+        mutable std::mutex lock;
+        std::list<Item> lru;  // most recent first
+        std::unordered_map<PuzzleKey, std::list<Item>::iterator, PuzzleKeyHash> map;
+    };
+
+    Shard& shardOf(const PuzzleKey& key) { return shards[(key.hash() >> 32) % shards.size()]; }
+
+    std::vector<Shard> shards;
+    size_t shardCapacity;
+    std::atomic<uint64_t> hitCount{ 0 };
+    std::atomic<uint64_t> missCount{ 0 };
+};
+
+// Puts a SolutionCache in front of another engine. Puzzles are solved in
+// their original frame; the solution is stored in the canonical frame and
+// mapped back through the symmetry transform on a hit.
+class CachedSolver : public ISudokuSolver
+{
+public:
+    explicit CachedSolver(std::unique_ptr<ISudokuSolver> inner,
+        std::shared_ptr<SolutionCache> cache = std::make_shared<SolutionCache>());
+
+    SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
+
+    // folds canonical duplicates inside the batch before solving
+    SolveStats solveAll(std::vector<Sudoku>& sudokus) override;
+
+    const char* getName() const override { return name.c_str(); }
+
+    const SolutionCache& getCache() const { return *cache; }
+    uint64_t foldedCount() const { return folded.load(std::memory_order_relaxed); }
+
+private:
+    SolveResult solveCanonical(Sudoku& sudoku, const CanonicalForm& form,
+        SearchStats& search, const SolveBudget& budget);
+
+    std::unique_ptr<ISudokuSolver> inner;
+    std::shared_ptr<SolutionCache> cache;
+    std::string name;
+    std::atomic<uint64_t> folded{ 0 };
+};
@@ -0,0 +1,351 @@
+#include "SolutionStore.h"
+#include "DatasetLoader.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr uint64_t STORE_MAGIC = 0x3152544F53445553ull; // "SUDSTOR1"
+static constexpr uint64_t TAG_PUBLISHED = 1ull << 63;
+static constexpr uint64_t TAG_CLAIMED = 1;
+
+struct SolutionStore::Header
+{
+    // magic and capacity must stay the first two words (read before mapping)
+    uint64_t magic;
+    uint64_t capacity;
+    std::atomic<uint64_t> count;
+    uint8_t pad[104];
+};
+
+struct alignas(128) SolutionStore::Slot
+{
+    std::atomic<uint64_t> tag;  // 0 = empty, TAG_CLAIMED = being written, else hash | TAG_PUBLISHED
+    PuzzleKey puzzle;
+    PuzzleKey solution;
+    uint32_t costNs;
+    uint8_t result;
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == 8 && std::atomic<uint64_t>::is_always_lock_free,
+    "store tags must be lock-free 64-bit atomics");
+
+/* ============================================================
+   MAPPING
+   ============================================================ */
+SolutionStore::~SolutionStore()
+{
+    close();
+}
+
+bool SolutionStore::open(const std::string& path, uint64_t requested)
+{
+    static_assert(sizeof(Header) == 128 && sizeof(Slot) == 128, "slot layout is part of the file format");
+    close();
+
+    uint64_t capacity = 64;
+    while (capacity < requested)
+        capacity <<= 1;
+
+#ifdef _WIN32
+    HANDLE h = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+    file = h;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h, &size)) { close(); return false; }
+    uint64_t existing = (uint64_t)size.QuadPart;
+#else
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(); return false; }
+    uint64_t existing = (uint64_t)st.st_size;
+#endif
+
+    if (existing >= sizeof(Header))
+    {
+        // existing store: magic + capacity from the header
+        uint64_t h[2] = {};
+#ifdef _WIN32
+        DWORD read = 0;
+        if (!ReadFile((HANDLE)file, h, (DWORD)sizeof(h), &read, nullptr) || read != sizeof(h)) { close(); return false; }
+#else
+        if (pread(fd, h, sizeof(h), 0) != (ssize_t)sizeof(h)) { close(); return false; }
+#endif
+        if (h[0] != STORE_MAGIC || h[1] == 0 || (h[1] & (h[1] - 1)) != 0 ||
+            existing < sizeof(Header) + h[1] * sizeof(Slot))
+        {
+            close();
+            return false;
+        }
+        capacity = h[1];
+    }
+
+    uint64_t bytes = sizeof(Header) + capacity * sizeof(Slot);
+    if (!map(bytes))
+    {
+        close();
+        return false;
+    }
+
+    // fresh file: new pages are zero, only the header needs writing
+    if (header->magic != STORE_MAGIC)
+    {
+        header->capacity = capacity;
+        header->magic = STORE_MAGIC;
+    }
+    mask = capacity - 1;
+    return true;
+}
+
+bool SolutionStore::map(uint64_t bytes)
+{
+#ifdef _WIN32
+    HANDLE m = CreateFileMappingA((HANDLE)file, nullptr, PAGE_READWRITE,
+        (DWORD)(bytes >> 32), (DWORD)(bytes & 0xFFFFFFFFu), nullptr);
+    if (!m)
+        return false;
+    mapping = m;
+    void* p = MapViewOfFile(m, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)bytes);
+    if (!p)
+        return false;
+#else
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        return false;
+    if ((uint64_t)st.st_size < bytes && ftruncate(fd, (off_t)bytes) != 0)
+        return false;
+    void* p = mmap(nullptr, (size_t)bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return false;
+#endif
+    mappedBytes = bytes;
+    header = static_cast<Header*>(p);
+    slots = reinterpret_cast<Slot*>(static_cast<uint8_t*>(p) + sizeof(Header));
+    return true;
+}
+
+void SolutionStore::close()
+{
+#ifdef _WIN32
+    if (header) UnmapViewOfFile(header);
+    if (mapping) CloseHandle((HANDLE)mapping);
+    if (file) CloseHandle((HANDLE)file);
+    mapping = nullptr;
+    file = nullptr;
+#else
+    if (header) munmap(header, (size_t)mappedBytes);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    header = nullptr;
+    slots = nullptr;
+    mask = 0;
+    mappedBytes = 0;
+}
+
+void SolutionStore::flush()
+{
+    if (!header)
+        return;
+#ifdef _WIN32
+    FlushViewOfFile(header, (SIZE_T)mappedBytes);
+#else
+    msync(header, (size_t)mappedBytes, MS_SYNC);
+#endif
+}
+
+uint64_t SolutionStore::capacity() const
+{
+    return header ? header->capacity : 0;
+}
+
+uint64_t SolutionStore::size() const
+{
+    return header ? header->count.load(std::memory_order_relaxed) : 0;
+}
+
+/* ============================================================
+   TABLE
+   ============================================================ */
+bool SolutionStore::lookup(const PuzzleKey& puzzle, Record& out) const
+{
+    if (!header)
+        return false;
+
+    uint64_t h = puzzle.hash();
+    uint64_t tag = (h | TAG_PUBLISHED) & ~TAG_CLAIMED;
+
+    for (uint64_t i = h & mask, n = 0; n <= mask; i = (i + 1) & mask, ++n)
+    {
+        const Slot& s = slots[i];
+        uint64_t t = s.tag.load(std::memory_order_acquire);
+        if (t == 0)
+            return false;
+        if (t != tag || !(s.puzzle == puzzle))
+            continue;
+
+        out.solution = s.solution;
+        out.result = (SolveResult)s.result;
+        out.costNs = s.costNs;
+        return true;
+    }
+    return false;
+}
+
+bool SolutionStore::insert(const PuzzleKey& puzzle, const Record& record)
+{
+    if (!header)
+        return false;
+    if (header->count.load(std::memory_order_relaxed) >= header->capacity / 4 * 3)
+        return false;
+
+    uint64_t h = puzzle.hash();
+    uint64_t tag = (h | TAG_PUBLISHED) & ~TAG_CLAIMED;
+
+    for (uint64_t i = h & mask, n = 0; n <= mask; i = (i + 1) & mask, ++n)
+    {
+        Slot& s = slots[i];
+        uint64_t t = s.tag.load(std::memory_order_acquire);
+        if (t == tag && s.puzzle == puzzle)
+            return false;  // already stored
+        if (t != 0)
+            continue;
+
+        uint64_t expected = 0;
+        if (!s.tag.compare_exchange_strong(expected, TAG_CLAIMED, std::memory_order_acq_rel))
+            continue;      // another writer took it
+
+        s.puzzle = puzzle;
+        s.solution = record.solution;
+        s.costNs = record.costNs;
+        s.result = (uint8_t)record.result;
+        s.tag.store(tag, std::memory_order_release);
+        header->count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+/* ============================================================
+   STORED SOLVER
+   ============================================================ */
+StoredSolver::StoredSolver(std::unique_ptr<ISudokuSolver> innerSolver, std::shared_ptr<SolutionStore> s)
+    : inner(std::move(innerSolver)), store(std::move(s))
+{
+    name = std::string("Stored ") + inner->getName();
+}
+
+SolveResult StoredSolver::solve(Sudoku& sudoku)
+{
+    SearchStats search;
+    return solveWithStats(sudoku, search);
+}
+
+SolveResult StoredSolver::solveWithStats(Sudoku& sudoku, SearchStats& search)
+{
+    return solveWithBudget(sudoku, search, SolveBudget());
+}
+
+SolveResult StoredSolver::solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget)
+{
+    if (sudoku.isSolved())
+        return SolveResult::AlreadySolved;
+
+    PuzzleKey key = PuzzleKey::pack(sudoku.rawGrid());
+    SolutionStore::Record rec;
+    if (store->lookup(key, rec))
+    {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        if (rec.result != SolveResult::Unsolvable)
+            rec.solution.unpack(sudoku.rawGridMutable());
+        return rec.result;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+    SolveResult r = inner->solveWithBudget(sudoku, search, budget);
+    Clock::time_point t1 = Clock::now();
+    if (r == SolveResult::BudgetExceeded)
+        return r;   // not an answer, a later unbounded solve may still store one
+
+    rec.result = r;
+    rec.costNs = (uint32_t)std::min<long long>(UINT32_MAX,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    rec.solution = r == SolveResult::Unsolvable ? PuzzleKey() : PuzzleKey::pack(sudoku.rawGrid());
+    store->insert(key, rec);
+    return r;
+}
+
+/* ============================================================
+   COMMAND
+   ============================================================ */
+int SolutionStore::runCommand(const CommandLine& cmd)
+{
+    const std::vector<std::string>& args = cmd.positional();
+    std::string action = args.size() > 1 ? args[1] : "info";
+    std::string path = cmd.get("path", DEFAULT_PATH);
+
+    if (cmd.has("help") || (action != "info" && action != "fill"))
+    {
+        std::cout << "Usage: Sudoku store info|fill [options]\n"
+            << "  --path FILE         store file (default: " << DEFAULT_PATH << ")\n"
+            << "  --capacity N        slots when creating (default: " << DEFAULT_CAPACITY << ")\n"
+            << "  fill: --solver NAME (default: logical-simd) --datasets 0,1 --dataset-root DIR --max N\n";
+        return cmd.has("help") ? 0 : 2;
+    }
+
+    std::shared_ptr<SolutionStore> store = std::make_shared<SolutionStore>();
+    if (!store->open(path, (uint64_t)std::max(64LL, cmd.getInt("capacity", (long long)DEFAULT_CAPACITY))))
+    {
+        std::cerr << "Cannot open store " << path << "\n";
+        return 1;
+    }
+
+    if (action == "fill")
+    {
+        std::unique_ptr<ISudokuSolver> inner = SolverRegistry::create(cmd.get("solver", "logical-simd"));
+        if (!inner)
+        {
+            std::cerr << "Unknown solver: " << cmd.get("solver") << "\n";
+            return 2;
+        }
+        StoredSolver solver(std::move(inner), store);
+
+        std::vector<long long> ids = cmd.getIntList("datasets");
+        if (ids.empty())
+            for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+                ids.push_back(d);
+        size_t maxPer = cmd.has("max") ? (size_t)std::max(1LL, cmd.getInt("max", 0)) : SIZE_MAX;
+
+        for (long long d : ids)
+        {
+            std::vector<Sudoku> ds = DatasetLoader::loadSingleDataset(
+                DatasetLoader::datasetFolder(cmd.get("dataset-root", "Dataset"), (int)d), maxPer);
+            solver.solveAll(ds);
+        }
+        store->flush();
+        std::cout << "[STORE] hits=" << solver.hits() << "\n";
+    }
+
+    std::cout << "[STORE] " << path << ": " << store->size() << " / "
+        << store->capacity() << " slots used\n";
+    return 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Canonical.h"
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+
+// On-disk open-addressing table: puzzle -> packed solution, SolveResult and
+// solve cost. The file is memory mapped; a slot is filled first and then
+// published with a release store of its tag, so readers never lock and
+// never see a half-written slot. Slots are never rewritten (append-only);
+// when the table is 3/4 full further inserts are refused.
+class SolutionStore
+{
+public:
+    struct Record
+    {
+        PuzzleKey solution;
+        SolveResult result;
+        uint32_t costNs;
+    };
+
+    static constexpr const char* DEFAULT_PATH = "solutions.store";
+    static constexpr uint64_t DEFAULT_CAPACITY = 1 << 18;  // slots, 128 bytes each
+
+    SolutionStore() = default;
+    ~SolutionStore();
+    SolutionStore(const SolutionStore&) = delete;
+    SolutionStore& operator=(const SolutionStore&) = delete;
+
+    // creates the file with 'capacity' slots (rounded up to a power of two)
+    // if it does not exist; existing files keep their capacity
+    bool open(const std::string& path, uint64_t capacity = DEFAULT_CAPACITY);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    bool lookup(const PuzzleKey& puzzle, Record& out) const;
+    bool insert(const PuzzleKey& puzzle, const Record& record);  // false if full or present
+
+    void flush();  // msync / FlushViewOfFile
+
+    uint64_t capacity() const;
+    uint64_t size() const;
+
+    // "store" command: info / fill
+    static int runCommand(const CommandLine& cmd);
+
+private:
+    struct Header;
+    struct Slot;
+
+    bool map(uint64_t bytes);
+
+    Header* header = nullptr;
+    Slot* slots = nullptr;
+    uint64_t mask = 0;
+    uint64_t mappedBytes = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+// Looks puzzles up in a SolutionStore before running the inner engine and
+// records new results with their solve time.
+class StoredSolver : public ISudokuSolver
+{
+public:
+    StoredSolver(std::unique_ptr<ISudokuSolver> inner, std::shared_ptr<SolutionStore> store);
+
+    SolveResult solve(Sudoku& sudoku) override;
+    SolveResult solveWithStats(Sudoku& sudoku, SearchStats& search) override;
+    SolveResult solveWithBudget(Sudoku& sudoku, SearchStats& search, const SolveBudget& budget) override;
+    const char* getName() const override { return name.c_str(); }
+
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+
+private:
+    std::unique_ptr<ISudokuSolver> inner;
+    std::shared_ptr<SolutionStore> store;
+    std::string name;
+    std::atomic<uint64_t> hitCount{ 0 };
+};
@@ -0,0 +1,332 @@
+#include "SolveServer.h"
+#include "BudgetedSolver.h"
+#include "MicroBatcher.h"
+#include "SolverRegistry.h"
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Output side of one client. Responses are appended by the batch workers
+// and written once per batch (see flushDirty).
+struct Connection
+{
+    int fd = -1;                 // -1 = stdout
+    std::mutex lock;             // pending
+    std::mutex writeLock;        // one writer at a time, held across send()
+    std::string pending;
+
+    ~Connection()
+    {
+        flush();
+#ifndef _WIN32
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    // Several batch workers and the reader thread may flush the same
+    // connection; a partial send() must not interleave with another writer.
+    void flush()
+    {
+        std::lock_guard<std::mutex> writer(writeLock);
+        std::string out;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            out.swap(pending);
+        }
+        if (out.empty())
+            return;
+
+        if (fd < 0)
+        {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            std::fflush(stdout);
+            return;
+        }
+#ifndef _WIN32
+        size_t sent = 0;
+        while (sent < out.size())
+        {
+            ssize_t n = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;   // client went away
+            sent += (size_t)n;
+        }
+#endif
+    }
+
+    // true if the buffer was empty (caller marks the connection dirty)
+    bool append(const std::string& line)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        bool first = pending.empty();
+        pending += line;
+        return first;
+    }
+};
+
+// connections that got responses during the current batch of this worker
+thread_local std::vector<std::shared_ptr<Connection>> dirty;
+
+void flushDirty()
+{
+    for (auto& c : dirty)
+        c->flush();
+    dirty.clear();
+}
+
+void respond(const std::shared_ptr<Connection>& conn, const std::string& line)
+{
+    if (conn->append(line))
+        dirty.push_back(conn);
+}
+
+bool parsePuzzle(const std::string& text, Sudoku& out)
+{
+    if (text.size() != NUMBER_COUNT * NUMBER_COUNT)
+        return false;
+    uint8_t* g = out.rawGridMutable();
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        char ch = text[i];
+        if (ch == '.' || ch == '0') g[i] = UNASSIGNED;
+        else if (ch >= '1' && ch <= '9') g[i] = (uint8_t)(ch - '0');
+        else return false;
+    }
+    return out.isConsistent();
+}
+
+struct Server
+{
+    MicroBatcher& batcher;
+    MicroBatcher* slowLane;   // puzzles over budget, nullptr without a budget
+
+    std::string statsLine() const
+    {
+        uint64_t done = batcher.completedCount(), bat = batcher.batchCount();
+        std::string line = "STATS requests=" + std::to_string(batcher.requestCount()) +
+            " completed=" + std::to_string(done) + " batches=" + std::to_string(bat) +
+            " avg_batch=" + std::to_string(bat ? (double)done / (double)bat : 0.0);
+        if (slowLane)
+            line += " slow_lane=" + std::to_string(slowLane->requestCount()) +
+                " slow_completed=" + std::to_string(slowLane->completedCount());
+        return line + "\n";
+    }
+
+    // one request line; returns false on QUIT
+    bool handleLine(const std::shared_ptr<Connection>& conn, std::string line, uint64_t lineNo)
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        if (line.empty())
+            return true;
+        if (line == "QUIT")
+            return false;
+        if (line == "STATS")
+        {
+            conn->append(statsLine());
+            conn->flush();
+            return true;
+        }
+
+        std::string id = std::to_string(lineNo);
+        std::string puzzle = line;
+        size_t space = line.find(' ');
+        if (space != std::string::npos)
+        {
+            id = line.substr(0, space);
+            puzzle = line.substr(line.find_first_not_of(' ', space));
+        }
+
+        Sudoku s;
+        if (!parsePuzzle(puzzle, s))
+        {
+            conn->append(id + " ERROR expected 81 digits without conflicts\n");
+            conn->flush();
+            return true;
+        }
+
+        MicroBatcher::Callback reply = [conn, id](Sudoku& solved, SolveResult r) {
+            std::string out = id;
+            out += ' ';
+            out += solveResultName(r);
+            out += ' ';
+            const uint8_t* g = solved.rawGrid();
+            for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+                out += (char)('0' + g[i]);
+            out += '\n';
+            respond(conn, out);
+        };
+
+        batcher.submit(s, [this, reply](Sudoku& solved, SolveResult r) {
+            // hard puzzles leave the batch slot and finish unbounded on the slow lane
+            if (r == SolveResult::BudgetExceeded && slowLane)
+                slowLane->submit(solved, reply);
+            else
+                reply(solved, r);
+        });
+        return true;
+    }
+
+    void serveStdin()
+    {
+        std::shared_ptr<Connection> conn = std::make_shared<Connection>();
+        std::string line;
+        uint64_t lineNo = 0;
+        while (std::getline(std::cin, line))
+            if (!handleLine(conn, line, ++lineNo))
+                break;
+    }
+
+#ifndef _WIN32
+    void serveConnection(int fd)
+    {
+        std::shared_ptr<Connection> conn = std::make_shared<Connection>();
+        conn->fd = fd;
+
+        std::string buffer;
+        char chunk[4096];
+        uint64_t lineNo = 0;
+        while (true)
+        {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0)
+                return;
+            buffer.append(chunk, (size_t)n);
+
+            size_t start = 0, nl;
+            while ((nl = buffer.find('\n', start)) != std::string::npos)
+            {
+                if (!handleLine(conn, buffer.substr(start, nl - start), ++lineNo))
+                {
+                    shutdown(fd, SHUT_RD);
+                    return;
+                }
+                start = nl + 1;
+            }
+            buffer.erase(0, start);
+        }
+    }
+
+    int serveSocket(const std::string& path)
+    {
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0)
+        {
+            std::cerr << "socket() failed\n";
+            return 1;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path))
+        {
+            std::cerr << "Socket path too long: " << path << "\n";
+            return 1;
+        }
+        path.copy(addr.sun_path, path.size());
+        unlink(path.c_str());
+
+        if (bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 64) != 0)
+        {
+            std::cerr << "Cannot listen on " << path << "\n";
+            close(listener);
+            return 1;
+        }
+        std::cerr << "[SERVE] listening on " << path << "\n";
+
+        while (true)
+        {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+            std::thread([this, fd]() { serveConnection(fd); }).detach();
+        }
+    }
+#endif
+};
+
+}
+
+int SolveServer::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        std::cout << "Usage: Sudoku serve [options]\n"
+            << "  --solver NAME       engine (default: logical-simd)\n"
+            << "  --socket PATH       listen on a Unix socket instead of stdin/stdout\n"
+            << "  --batch N           max requests per batch (default: 64)\n"
+            << "  --window-us N       max wait for a batch to fill (default: 200)\n"
+            << "  --workers N         solver threads (default: all cores)\n"
+            << BudgetedSolver::usage()
+            << "                      (over-budget puzzles go to a separate slow lane)\n"
+            << "  --slow-workers N    slow lane threads (default: 1)\n";
+        return 0;
+    }
+
+    std::string solverName = cmd.get("solver", "logical-simd");
+    if (!SolverRegistry::create(solverName))
+    {
+        std::cerr << "Unknown solver: " << solverName << "\n";
+        return 2;
+    }
+
+    BatchOptions options;
+    options.maxBatch = (size_t)std::max(1LL, cmd.getInt("batch", (long long)options.maxBatch));
+    options.window = std::chrono::microseconds(std::max(0LL, cmd.getInt("window-us", options.window.count())));
+    options.workers = (unsigned)std::max(0LL, cmd.getInt("workers", 0));
+
+    // with a budget, the fast lane gives up early and the slow lane runs the
+    // escalation engine (default: the same engine) without one
+    BudgetOptions budget = BudgetOptions::fromCommandLine(cmd);
+    std::unique_ptr<MicroBatcher> slowLane;
+    if (budget.limited())
+    {
+        std::string slowName = cmd.get("escalate", solverName);
+        if (!SolverRegistry::create(slowName))
+        {
+            std::cerr << "Unknown escalation solver: " << slowName << "\n";
+            return 2;
+        }
+
+        BatchOptions slowOptions;
+        slowOptions.maxBatch = 1;
+        slowOptions.window = std::chrono::microseconds(0);
+        slowOptions.workers = (unsigned)std::max(1LL, cmd.getInt("slow-workers", 1));
+        slowLane.reset(new MicroBatcher([slowName]() { return SolverRegistry::create(slowName); },
+            slowOptions, flushDirty));
+    }
+
+    // one engine per batch worker, behind the budget when one is set
+    MicroBatcher batcher([&solverName, &budget]() {
+        return BudgetedSolver::wrap(SolverRegistry::create(solverName), budget, "");
+    }, options, flushDirty);
+    Server server{ batcher, slowLane.get() };
+
+    if (cmd.has("socket"))
+    {
+#ifdef _WIN32
+        std::cerr << "--socket is not supported on Windows, use stdin/stdout\n";
+        return 2;
+#else
+        return server.serveSocket(cmd.get("socket"));
+#endif
+    }
+
+    std::ios::sync_with_stdio(false);
+    server.serveStdin();
+    batcher.shutdown();   // answer everything that is still queued
+    if (slowLane)
+        slowLane->shutdown();
+    std::cerr << "[SERVE] " << server.statsLine();
+    return 0;
+}
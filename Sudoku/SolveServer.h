@@ -0,0 +1,18 @@
+#pragma once
+#include "CommandLine.h"
+
+// "serve" command: keeps a MicroBatcher warm (one engine per batch worker)
+// and answers line requests on stdin/stdout or a Unix domain socket.
+//
+// request : <puzzle>            81 chars, '0' or '.' = empty
+//           <id> <puzzle>
+//           STATS
+// response: <id> <SolveResult> <solution>
+//           <id> ERROR <message>
+// Responses may come back out of order; lines without an id get their
+// line number (starting at 1) as id.
+class SolveServer
+{
+public:
+    static int runCommand(const CommandLine& cmd);
+};
@@ -0,0 +1,113 @@
+#include "SolverRegistry.h"
+#include "BacktrackingSolver.h"
+#include "BacktrackingSolverMRV.h"
+#include "CDCLSolver.h"
+#include "LogicalPipeline.h"
+#include "LogicalSolver.h"
+#include "LogicalSolverSIMD.h"
+#include "RouterSolver.h"
+#include "SolutionCache.h"
+#include "SolutionStore.h"
+#include <iostream>
+
+namespace {
+
+struct Entry
+{
+    const char* name;
+    std::unique_ptr<ISudokuSolver>(*make)();
+};
+
+// calibrated model next to the binary if present, built-in weights otherwise
+std::unique_ptr<ISudokuSolver> makeRouter()
+{
+    RouterModel model = RouterModel::defaults();
+    model.load(RouterSolver::DEFAULT_MODEL_PATH);
+    return std::unique_ptr<ISudokuSolver>(new RouterSolver(model));
+}
+
+LogicalOptions uniqueOptions()
+{
+    LogicalOptions o;
+    o.assumeUnique = true;
+    return o;
+}
+
+std::unique_ptr<ISudokuSolver> makeMRV(MRVOptions::ValueOrder order, bool randomTies, uint64_t restartUnit)
+{
+    MRVOptions o;
+    o.valueOrder = order;
+    o.randomTies = randomTies;
+    o.restartUnit = restartUnit;
+    return std::unique_ptr<ISudokuSolver>(new BacktrackingSolverMRV(o));
+}
+
+LogicalOptions noLookaheadOptions()
+{
+    LogicalOptions o;
+    o.lookaheadDepth = 0;
+    return o;
+}
+
+const Entry ENTRIES[] = {
+    { "backtracking",       [] { return std::unique_ptr<ISudokuSolver>(new BacktrackingSolver()); } },
+    { "mrv",                [] { return std::unique_ptr<ISudokuSolver>(new BacktrackingSolverMRV()); } },
+    { "mrv-lcv",            [] { return makeMRV(MRVOptions::ValueOrder::LeastConstraining, false, 0); } },
+    { "mrv-freq",           [] { return makeMRV(MRVOptions::ValueOrder::DigitFrequency, false, 0); } },
+    { "mrv-random",         [] { return makeMRV(MRVOptions::ValueOrder::Ascending, true, 0); } },
+    { "mrv-luby",           [] { return makeMRV(MRVOptions::ValueOrder::Ascending, true, 1024); } },
+    { "logical",            [] { return std::unique_ptr<ISudokuSolver>(new LogicalSolver()); } },
+    { "logical-simd",       [] { return std::unique_ptr<ISudokuSolver>(new LogicalSolverSIMD()); } },
+    { "logical-unique",     [] { return std::unique_ptr<ISudokuSolver>(new LogicalSolver(uniqueOptions())); } },
+    { "logical-simd-unique",[] { return std::unique_ptr<ISudokuSolver>(new LogicalSolverSIMD(uniqueOptions())); } },
+    { "logical-nolookahead",[] { return std::unique_ptr<ISudokuSolver>(new LogicalSolver(noLookaheadOptions())); } },
+    { "logical-singles",    [] { return std::unique_ptr<ISudokuSolver>(new SinglesPipeline()); } },
+    { "logical-locked",     [] { return std::unique_ptr<ISudokuSolver>(new LockedPipeline()); } },
+    { "logical-pipeline",   [] { return std::unique_ptr<ISudokuSolver>(new StandardPipeline()); } },
+    { "cdcl",               [] { return std::unique_ptr<ISudokuSolver>(new CDCLSolver()); } },
+    { "router",             makeRouter },
+};
+
+}
+
+std::unique_ptr<ISudokuSolver> SolverRegistry::create(const std::string& name)
+{
+    // "cached-<engine>": canonical-form result cache in front of <engine>
+    if (name.rfind("cached-", 0) == 0)
+    {
+        std::unique_ptr<ISudokuSolver> inner = create(name.substr(7));
+        if (!inner)
+            return nullptr;
+        return std::unique_ptr<ISudokuSolver>(new CachedSolver(std::move(inner)));
+    }
+
+    // "stored-<engine>": persistent solution store (solutions.store) in front of <engine>
+    if (name.rfind("stored-", 0) == 0)
+    {
+        std::unique_ptr<ISudokuSolver> inner = create(name.substr(7));
+        if (!inner)
+            return nullptr;
+
+        std::shared_ptr<SolutionStore> store = std::make_shared<SolutionStore>();
+        if (!store->open(SolutionStore::DEFAULT_PATH))
+        {
+            std::cerr << "[WARN] Cannot open " << SolutionStore::DEFAULT_PATH
+                << ", running " << inner->getName() << " without it\n";
+            return inner;
+        }
+        return std::unique_ptr<ISudokuSolver>(new StoredSolver(std::move(inner), store));
+    }
+
+    for (const Entry& e : ENTRIES)
+        if (name == e.name)
+            return e.make();
+    return nullptr;
+}
+
+std::vector<std::string> SolverRegistry::names()
+{
+    std::vector<std::string> out;
+    for (const Entry& e : ENTRIES)
+        out.push_back(e.name);
+    return out;
+}
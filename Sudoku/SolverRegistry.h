@@ -0,0 +1,16 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "ISudokuSolver.h"
+
+// Name -> solver factory, used by the command modes to pick engines
+// at runtime instead of editing main.cpp.
+class SolverRegistry
+{
+public:
+    // nullptr if the name is unknown
+    static std::unique_ptr<ISudokuSolver> create(const std::string& name);
+
+    static std::vector<std::string> names();
+};
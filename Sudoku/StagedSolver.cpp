@@ -0,0 +1,363 @@
+#include "StagedSolver.h"
+#include "DatasetLoader.h"
+#include "LogicalPipeline.h"
+#include "ParallelSolver.h"
+#include "SolverRegistry.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Chunk = std::vector<uint32_t>;   // puzzle indices
+
+// Hand-over between two stages. Closed once every producer thread is done.
+class ChunkQueue
+{
+public:
+    explicit ChunkQueue(unsigned producerCount) : producers(producerCount) {}
+
+    void push(Chunk&& chunk)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            chunks.push_back(std::move(chunk));
+        }
+        ready.notify_one();
+    }
+
+    // false when closed and drained
+    bool pop(Chunk& out)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ready.wait(guard, [this] { return !chunks.empty() || producers == 0; });
+        if (chunks.empty())
+            return false;
+        out = std::move(chunks.front());
+        chunks.pop_front();
+        return true;
+    }
+
+    void producerDone()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            --producers;
+        }
+        ready.notify_all();
+    }
+
+private:
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<Chunk> chunks;
+    unsigned producers;
+};
+
+}
+
+StagedSolver::StagedSolver(const StageOptions& opts) : options(opts)
+{
+    createSearch();   // throws on unknown engine names here, not in solveAll
+
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned defaults[STAGE_COUNT];
+    defaults[STAGE_SINGLES] = std::max(1u, hw / 4);
+    defaults[STAGE_SEARCH] = std::max(1u, hw / 4);
+    defaults[STAGE_LOGIC] = std::max(1u, hw - std::min(hw, defaults[STAGE_SINGLES] + defaults[STAGE_SEARCH]));
+    for (int st = 0; st < STAGE_COUNT; ++st)
+        if (options.threads[st] == 0)
+            options.threads[st] = defaults[st];
+    options.chunk = std::max<size_t>(1, options.chunk);
+}
+
+std::unique_ptr<ISudokuSolver> StagedSolver::createSearch() const
+{
+    std::unique_ptr<ISudokuSolver> engine = SolverRegistry::create(options.searchEngine);
+    if (!engine)
+        throw std::runtime_error("StagedSolver: unknown search engine " + options.searchEngine);
+    return BudgetedSolver::wrap(std::move(engine), options.budget, options.escalate);
+}
+
+SolveStats StagedSolver::solveAll(std::vector<Sudoku>& sudokus, std::vector<SolveResult>* results)
+{
+    std::vector<SolveResult> local;
+    std::vector<SolveResult>& out = results ? *results : local;
+    out.assign(sudokus.size(), SolveResult::Unsolvable);
+
+    stageStats = StageStats();
+    for (int st = 0; st < STAGE_COUNT; ++st)
+        stageStats.threads[st] = options.threads[st];
+
+    ChunkQueue toLogic(options.threads[STAGE_SINGLES]);
+    ChunkQueue toSearch(options.threads[STAGE_LOGIC]);
+    std::atomic<size_t> next{ 0 };
+    std::mutex statsLock;
+    std::vector<SearchStats> searches(options.threads[STAGE_SEARCH]);
+    std::vector<std::unique_ptr<ISudokuSolver>> engines(options.threads[STAGE_SEARCH]);
+    for (auto& engine : engines)
+        engine = createSearch();
+
+    // per-thread counters, merged once when the thread ends
+    auto finish = [&](int st, uint64_t in, uint64_t solved, uint64_t busyNs) {
+        std::lock_guard<std::mutex> guard(statsLock);
+        stageStats.in[st] += in;
+        stageStats.solved[st] += solved;
+        stageStats.busyNs[st] += busyNs;
+    };
+    auto elapsedNs = [](Clock::time_point t0) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    };
+
+    auto singlesWorker = [&]() {
+        SinglesPipeline engine;
+        Trace::nameThread("stage singles");
+        uint64_t in = 0, solved = 0, busy = 0;
+        Chunk residue;
+        while (true)
+        {
+            size_t begin = next.fetch_add(options.chunk, std::memory_order_relaxed);
+            if (begin >= sudokus.size())
+                break;
+            size_t end = std::min(sudokus.size(), begin + options.chunk);
+
+            TRACE_SCOPE("singles chunk", "stage", (int64_t)(end - begin));
+            Clock::time_point t0 = Clock::now();
+            for (size_t i = begin; i < end; ++i)
+            {
+                Sudoku& s = sudokus[i];
+                ++in;
+                if (s.isSolved())
+                {
+                    out[i] = SolveResult::AlreadySolved;
+                    ++solved;
+                    continue;
+                }
+                s.recomputeCandidates();
+                if (engine.run(s))
+                {
+                    out[i] = SolveResult::SolvedByLogical;
+                    ++solved;
+                }
+                else
+                    residue.push_back((uint32_t)i);
+            }
+            busy += elapsedNs(t0);
+
+            if (residue.size() >= options.chunk)
+                toLogic.push(std::move(residue)), residue.clear();
+        }
+        if (!residue.empty())
+            toLogic.push(std::move(residue));
+        toLogic.producerDone();
+        finish(STAGE_SINGLES, in, solved, busy);
+    };
+
+    auto logicWorker = [&]() {
+        StandardPipeline engine;
+        Trace::nameThread("stage logic");
+        uint64_t in = 0, solved = 0, busy = 0;
+        Chunk chunk, residue;
+        while (toLogic.pop(chunk))
+        {
+            TRACE_SCOPE("logic chunk", "stage", (int64_t)chunk.size());
+            Clock::time_point t0 = Clock::now();
+            for (uint32_t i : chunk)
+            {
+                ++in;
+                // candidates carried over from the singles stage
+                if (engine.run(sudokus[i]))
+                {
+                    out[i] = SolveResult::SolvedByLogical;
+                    ++solved;
+                }
+                else
+                    residue.push_back(i);
+            }
+            busy += elapsedNs(t0);
+
+            if (residue.size() >= options.chunk)
+                toSearch.push(std::move(residue)), residue.clear();
+        }
+        if (!residue.empty())
+            toSearch.push(std::move(residue));
+        toSearch.producerDone();
+        finish(STAGE_LOGIC, in, solved, busy);
+    };
+
+    auto searchWorker = [&](unsigned t) {
+        Trace::nameThread("stage search");
+        uint64_t in = 0, solved = 0, busy = 0;
+        Chunk chunk;
+        while (toSearch.pop(chunk))
+        {
+            TRACE_SCOPE("search chunk", "stage", (int64_t)chunk.size());
+            Clock::time_point t0 = Clock::now();
+            for (uint32_t i : chunk)
+            {
+                ++in;
+                out[i] = engines[t]->solveWithStats(sudokus[i], searches[t]);
+                if (out[i] == SolveResult::SolvedByBacktracking || out[i] == SolveResult::SolvedByLogical)
+                    ++solved;
+            }
+            busy += elapsedNs(t0);
+        }
+        finish(STAGE_SEARCH, in, solved, busy);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < options.threads[STAGE_SINGLES]; ++t)
+        pool.emplace_back(singlesWorker);
+    for (unsigned t = 0; t < options.threads[STAGE_LOGIC]; ++t)
+        pool.emplace_back(logicWorker);
+    for (unsigned t = 0; t < options.threads[STAGE_SEARCH]; ++t)
+        pool.emplace_back(searchWorker, t);
+    for (std::thread& th : pool)
+        th.join();
+
+    SolveStats stats;
+    for (SolveResult r : out)
+    {
+        if (r == SolveResult::AlreadySolved) ++stats.alreadySolved;
+        else if (r == SolveResult::SolvedByLogical) ++stats.logical;
+        else if (r == SolveResult::SolvedByBacktracking) ++stats.backtracking;
+        else if (r == SolveResult::BudgetExceeded) ++stats.budgetExceeded;
+        else ++stats.unsolvable;
+    }
+    for (const SearchStats& s : searches)
+        stats.search.merge(s);
+    return stats;
+}
+
+void StagedSolver::printStageStats(std::ostream& os) const
+{
+    static const char* const NAMES[STAGE_COUNT] = { "singles", "logic", "search" };
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    for (int st = 0; st < STAGE_COUNT; ++st)
+    {
+        os << "  " << std::left << std::setw(8) << NAMES[st] << std::right
+            << " threads=" << stageStats.threads[st]
+            << " in=" << stageStats.in[st]
+            << " solved=" << stageStats.solved[st]
+            << " busy_ms=" << (double)stageStats.busyNs[st] / 1e6
+            << " us/puzzle=" << (stageStats.in[st] ? (double)stageStats.busyNs[st] / 1e3 / (double)stageStats.in[st] : 0.0)
+            << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+int StagedSolver::runCommand(const CommandLine& cmd)
+{
+    if (cmd.has("help"))
+    {
+        std::cout << "Usage: Sudoku stages [options]\n"
+            << "  --datasets 0,1,5    dataset indices (default: all)\n"
+            << "  --dataset-root DIR  (default: Dataset)\n"
+            << "  --max N             puzzles per dataset (default: all)\n"
+            << "  --singles-threads N threads of the singles stage (default: cores/4)\n"
+            << "  --logic-threads N   threads of the logic stage (default: the rest)\n"
+            << "  --search-threads N  threads of the search stage (default: cores/4)\n"
+            << "  --chunk N           puzzles per hand-over (default: 32)\n"
+            << "  --search NAME       search stage engine (default: mrv)\n"
+            << BudgetedSolver::usage()
+            << "  --compare NAME      ParallelSolver engine on the same thread total,\n"
+            << "                      \"none\" to skip (default: logical-simd)\n";
+        return 0;
+    }
+
+    StageOptions options;
+    options.threads[STAGE_SINGLES] = (unsigned)std::max(0LL, cmd.getInt("singles-threads", 0));
+    options.threads[STAGE_LOGIC] = (unsigned)std::max(0LL, cmd.getInt("logic-threads", 0));
+    options.threads[STAGE_SEARCH] = (unsigned)std::max(0LL, cmd.getInt("search-threads", 0));
+    options.chunk = (size_t)std::max(1LL, cmd.getInt("chunk", (long long)options.chunk));
+    options.searchEngine = cmd.get("search", options.searchEngine);
+    options.budget = BudgetOptions::fromCommandLine(cmd);
+    options.escalate = cmd.get("escalate");
+
+    if (!SolverRegistry::create(options.searchEngine))
+    {
+        std::cerr << "Unknown solver: " << options.searchEngine << "\n";
+        return 2;
+    }
+    if (!options.escalate.empty() && !SolverRegistry::create(options.escalate))
+    {
+        std::cerr << "Unknown escalation solver: " << options.escalate << "\n";
+        return 2;
+    }
+
+    std::string compareName = cmd.get("compare", "logical-simd");
+    std::unique_ptr<ISudokuSolver> compare;
+    if (compareName != "none")
+    {
+        compare = SolverRegistry::create(compareName);
+        if (!compare)
+        {
+            std::cerr << "Unknown solver: " << compareName << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<long long> ids = cmd.getIntList("datasets");
+    if (ids.empty())
+        for (int d = 0; d < DatasetLoader::DATASET_COUNT; ++d)
+            ids.push_back(d);
+    std::string root = cmd.get("dataset-root", "Dataset");
+    size_t maxPer = cmd.has("max") ? (size_t)std::max(1LL, cmd.getInt("max", 1)) : SIZE_MAX;
+
+    StagedSolver staged(options);
+    unsigned totalThreads = 0;
+    for (int st = 0; st < STAGE_COUNT; ++st)
+        totalThreads += staged.options.threads[st];
+
+    int differing = 0;
+    for (long long d : ids)
+    {
+        std::vector<Sudoku> base = DatasetLoader::loadSingleDataset(
+            DatasetLoader::datasetFolder(root, (int)d), maxPer);
+        if (base.empty())
+            continue;
+
+        std::vector<Sudoku> work = base;
+        Clock::time_point t0 = Clock::now();
+        SolveStats stats = staged.solveAll(work);
+        double stagedMs = (double)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count() / 1000.0;
+
+        std::cout << "[STAGES] Dataset" << d << " (" << base.size() << " sudokus): " << stagedMs << " ms"
+            << " logical=" << stats.logical << " search=" << stats.backtracking
+            << " unsolvable=" << stats.unsolvable;
+        if (stats.budgetExceeded)
+            std::cout << " budget_exceeded=" << stats.budgetExceeded;
+        std::cout << "\n";
+        staged.printStageStats(std::cout);
+
+        if (compare)
+        {
+            std::vector<Sudoku> ref = base;
+            Clock::time_point c0 = Clock::now();
+            ParallelSolver::solveAll(*compare, ref, totalThreads);
+            double refMs = (double)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - c0).count() / 1000.0;
+
+            size_t diff = 0;
+            for (size_t i = 0; i < ref.size(); ++i)
+                if (ref[i] != work[i])
+                    ++diff;
+            differing += diff != 0;
+            std::cout << "  " << compareName << " x" << totalThreads << ": " << refMs << " ms"
+                << (diff ? " [DIFF] " + std::to_string(diff) + " grids differ" : std::string()) << "\n";
+        }
+    }
+    return differing ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "BudgetedSolver.h"
+#include "CommandLine.h"
+#include "ISudokuSolver.h"
+
+enum {
+    STAGE_SINGLES = 0,   // candidates + naked/hidden singles over everything
+    STAGE_LOGIC,         // full technique chain on what singles left
+    STAGE_SEARCH,        // search engine on the logical residue
+    STAGE_COUNT
+};
+
+struct StageOptions
+{
+    unsigned threads[STAGE_COUNT] = { 0, 0, 0 };   // 0 = split hardware_concurrency
+    size_t chunk = 32;                              // puzzles per queue hand-over
+    std::string searchEngine = "mrv";               // registry name for the last stage
+    BudgetOptions budget;                           // per-puzzle budget of the search stage
+    std::string escalate;                           // engine for puzzles over budget
+};
+
+struct StageStats
+{
+    uint64_t in[STAGE_COUNT] = {};       // puzzles that reached the stage
+    uint64_t solved[STAGE_COUNT] = {};   // puzzles finished by the stage
+    uint64_t busyNs[STAGE_COUNT] = {};   // summed solve time of the stage threads
+    unsigned threads[STAGE_COUNT] = {};
+};
+
+// CPU version of the CUDASolver shape as a batch pipeline: a bulk singles
+// pass over every puzzle, an advanced logic pass over what is left, then
+// search over the residue. Each stage has its own threads and input queue
+// and starts as soon as the previous one hands over its first chunk.
+// Puzzles move between stages by index; their candidate masks stay in the
+// Sudoku objects, so the logic stage continues from the singles state
+// instead of recomputing it.
+class StagedSolver
+{
+public:
+    explicit StagedSolver(const StageOptions& options = StageOptions());
+
+    // solves in place; results[i] is filled when non-null
+    SolveStats solveAll(std::vector<Sudoku>& sudokus, std::vector<SolveResult>* results = nullptr);
+
+    const StageStats& getStageStats() const { return stageStats; }
+    void printStageStats(std::ostream& os) const;
+
+    // "stages" command: staged pipeline vs ParallelSolver on the same threads
+    static int runCommand(const CommandLine& cmd);
+
+private:
+    // search engine behind the budget; one per search thread, engines keep
+    // per-solve state
+    std::unique_ptr<ISudokuSolver> createSearch() const;
+
+    StageOptions options;
+    StageStats stageStats;
+};
@@ -146,6 +146,27 @@ bool Sudoku::loadFromFile(std::string input)
 	return true;
 }
 
+bool Sudoku::isConsistent() const
+{
+	uint16_t used[UNIT_COUNT] = {};
+	for (int i = 0; i < NUMBER_COUNT * NUMBER_COUNT; ++i)
+	{
+		uint8_t v = data[i];
+		if (v == UNASSIGNED)
+			continue;
+		if (v > NUMBER_COUNT)
+			return false;
+		const uint8_t* u = UNITS.ofCell[i];
+		uint16_t b = bit(v);
+		if ((used[u[0]] | used[u[1]] | used[u[2]]) & b)
+			return false;
+		used[u[0]] |= b;
+		used[u[1]] |= b;
+		used[u[2]] |= b;
+	}
+	return true;
+}
+
 bool Sudoku::validate() const
 {
 	for (int r = 0; r < 9; ++r) {
@@ -27,6 +27,36 @@ static inline uint8_t extractSingleValue(uint16_t m)
 	return static_cast<uint8_t>(std::countr_zero(m) + 1);
 }
 
+// unit tables (internal)
+// units 0..8 = rows, 9..17 = columns, 18..26 = boxes
+#define UNIT_COUNT 27
+
+struct UnitTable
+{
+	uint8_t cells[UNIT_COUNT][NUMBER_COUNT];       // cell indices of each unit
+	uint8_t ofCell[NUMBER_COUNT * NUMBER_COUNT][3]; // row / column / box unit of each cell
+};
+
+static constexpr UnitTable makeUnitTable()
+{
+	UnitTable t{};
+	for (uint8_t r = 0; r < NUMBER_COUNT; ++r)
+		for (uint8_t c = 0; c < NUMBER_COUNT; ++c)
+		{
+			uint8_t b = (r / 3) * 3 + c / 3;
+			uint8_t k = (r % 3) * 3 + c % 3;
+			t.cells[r][c] = POS(r, c);
+			t.cells[9 + c][r] = POS(r, c);
+			t.cells[18 + b][k] = POS(r, c);
+			t.ofCell[POS(r, c)][0] = r;
+			t.ofCell[POS(r, c)][1] = 9 + c;
+			t.ofCell[POS(r, c)][2] = 18 + b;
+		}
+	return t;
+}
+
+inline constexpr UnitTable UNITS = makeUnitTable();
+
 class Sudoku
 {
 
@@ -134,6 +164,7 @@ public:
 	void writeRaw(std::ostream& os) const;
 	void readRaw(std::istream& is);
 	bool validate() const;
+	bool isConsistent() const; // validate() without printing, for request paths
 	bool operator==(const Sudoku& other) const;
 	bool operator!=(const Sudoku& other) const;
 	bool isSolved() const;
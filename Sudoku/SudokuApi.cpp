@@ -0,0 +1,316 @@
+#include "SudokuApi.h"
+#include "SolverRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr const char* DEFAULT_ENGINE = "logical-simd";
+constexpr size_t CHUNK = 64;       // puzzles claimed per index fetch
+
+// layouts of the version 1 header: the structs only grew at the end
+constexpr size_t OPTIONS_V1_SIZE = offsetof(sudoku_options, max_nodes);
+constexpr size_t STATS_V1_SIZE = offsetof(sudoku_stats, budget_exceeded);
+
+// true if a caller struct of 'size' bytes holds the field at offset..offset+bytes
+constexpr bool fits(size_t size, size_t offset, size_t bytes) { return offset + bytes <= size; }
+
+// copies as much of 'from' as the caller's struct holds
+void writeStats(sudoku_stats* to, const sudoku_stats& from, size_t size)
+{
+    std::memcpy(to, &from, std::min(size, sizeof(sudoku_stats)));
+}
+
+// Engines keep per-instance state while solving (LogicalSolver counts
+// technique hits, search engines reuse scratch buffers), so every worker
+// borrows an instance of its own. Returned instances are pooled per name and
+// serve later calls; the pool grows to the peak number of concurrent workers.
+std::mutex enginesLock;
+std::map<std::string, std::vector<std::unique_ptr<ISudokuSolver>>> engines;
+
+class EngineLease
+{
+public:
+    explicit EngineLease(const std::string& name) : name(name)
+    {
+        {
+            std::lock_guard<std::mutex> guard(enginesLock);
+            auto it = engines.find(name);
+            if (it != engines.end() && !it->second.empty())
+            {
+                solver = std::move(it->second.back());
+                it->second.pop_back();
+                return;
+            }
+        }
+        solver = SolverRegistry::create(name);   // nullptr for unknown names
+    }
+
+    ~EngineLease()
+    {
+        if (!solver)
+            return;
+        std::lock_guard<std::mutex> guard(enginesLock);
+        engines[name].push_back(std::move(solver));
+    }
+
+    EngineLease(const EngineLease&) = delete;
+    EngineLease& operator=(const EngineLease&) = delete;
+
+    ISudokuSolver* get() const { return solver.get(); }
+
+private:
+    std::string name;
+    std::unique_ptr<ISudokuSolver> solver;
+};
+
+std::mutex totalsLock;
+sudoku_stats totals{};
+
+std::vector<std::string>& engineNames()
+{
+    static std::vector<std::string> names = SolverRegistry::names();
+    return names;
+}
+
+uint8_t statusOf(SolveResult r)
+{
+    switch (r)
+    {
+    case SolveResult::AlreadySolved: return SUDOKU_STATUS_ALREADY_SOLVED;
+    case SolveResult::SolvedByLogical: return SUDOKU_STATUS_SOLVED_LOGICAL;
+    case SolveResult::SolvedByBacktracking: return SUDOKU_STATUS_SOLVED_SEARCH;
+    case SolveResult::BudgetExceeded: return SUDOKU_STATUS_BUDGET_EXCEEDED;
+    default: return SUDOKU_STATUS_UNSOLVABLE;
+    }
+}
+
+struct alignas(64) WorkerStats
+{
+    uint64_t counts[6] = {};      // indexed by SUDOKU_STATUS_*
+    SearchStats search;
+};
+
+void solveRange(ISudokuSolver& solver, const sudoku_options& opts, const uint8_t* in,
+    uint8_t* out, uint8_t* status, size_t n, std::atomic<size_t>& next, WorkerStats& ws)
+{
+    while (true)
+    {
+        size_t begin = next.fetch_add(CHUNK, std::memory_order_relaxed);
+        if (begin >= n)
+            return;
+        size_t end = std::min(n, begin + CHUNK);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const uint8_t* src = in + i * SUDOKU_CELLS;
+            uint8_t* dst = out + i * SUDOKU_CELLS;
+
+            Sudoku s;   // on the stack: no per-puzzle allocation
+            std::memcpy(s.rawGridMutable(), src, SUDOKU_CELLS);
+
+            uint8_t st;
+            if (!s.isConsistent())
+            {
+                st = SUDOKU_STATUS_INVALID;
+                if (dst != src)
+                    std::memcpy(dst, src, SUDOKU_CELLS);
+            }
+            else
+            {
+                SolveBudget budget = SolveBudget::of(opts.max_nodes,
+                    std::chrono::microseconds((long long)opts.time_limit_us));
+                st = statusOf(solver.solveWithBudget(s, ws.search, budget));
+                std::memcpy(dst, s.rawGrid(), SUDOKU_CELLS);
+            }
+
+            ++ws.counts[st];
+            if (status)
+                status[i] = st;
+        }
+    }
+}
+
+void addStats(sudoku_stats& to, const sudoku_stats& from)
+{
+    to.puzzles += from.puzzles;
+    to.already_solved += from.already_solved;
+    to.solved_logical += from.solved_logical;
+    to.solved_search += from.solved_search;
+    to.unsolvable += from.unsolvable;
+    to.invalid += from.invalid;
+    to.nodes += from.nodes;
+    to.guesses += from.guesses;
+    to.backtracks += from.backtracks;
+    to.max_depth = std::max(to.max_depth, from.max_depth);
+    to.threads = std::max(to.threads, from.threads);
+    to.elapsed_ns += from.elapsed_ns;
+    to.budget_exceeded += from.budget_exceeded;
+}
+
+}
+
+extern "C" {
+
+int sudoku_api_version(void)
+{
+    return SUDOKU_API_VERSION;
+}
+
+void sudoku_default_options(sudoku_options* options)
+{
+    if (!options)
+        return;
+    options->size = sizeof(sudoku_options);
+    options->threads = 0;
+    options->engine = nullptr;
+    options->max_nodes = 0;
+    options->time_limit_us = 0;
+    options->stats_size = sizeof(sudoku_stats);
+}
+
+int sudoku_solve_batch(const uint8_t* in, uint8_t* out, uint8_t* status,
+    size_t n, const sudoku_options* options, sudoku_stats* stats)
+{
+    if (n && (!in || !out))
+        return SUDOKU_ERROR_ARGUMENT;
+
+    // read only the fields the caller's header had
+    sudoku_options opts;
+    sudoku_default_options(&opts);
+    size_t statsSize = STATS_V1_SIZE;
+    if (options)
+    {
+        size_t size = options->size;
+        if (size < OPTIONS_V1_SIZE)
+            return SUDOKU_ERROR_ARGUMENT;
+        opts.threads = options->threads;
+        opts.engine = options->engine;
+        if (fits(size, offsetof(sudoku_options, max_nodes), sizeof(opts.max_nodes)))
+            opts.max_nodes = options->max_nodes;
+        if (fits(size, offsetof(sudoku_options, time_limit_us), sizeof(opts.time_limit_us)))
+            opts.time_limit_us = options->time_limit_us;
+        if (fits(size, offsetof(sudoku_options, stats_size), sizeof(opts.stats_size)) && options->stats_size)
+            statsSize = options->stats_size;
+    }
+
+    try {
+        std::string engine = opts.engine ? opts.engine : DEFAULT_ENGINE;
+        EngineLease lease(engine);   // the caller thread's engine
+        if (!lease.get())
+            return SUDOKU_ERROR_ENGINE;
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point t0 = Clock::now();
+
+        unsigned hw = std::thread::hardware_concurrency();
+        unsigned threads = opts.threads ? opts.threads : (hw ? hw : 1u);
+        threads = (unsigned)std::max<size_t>(1, std::min<size_t>(threads, (n + CHUNK - 1) / CHUNK));
+
+        std::atomic<size_t> next{ 0 };
+        std::vector<WorkerStats> workers(threads);
+        if (threads == 1)
+            solveRange(*lease.get(), opts, in, out, status, n, next, workers[0]);
+        else
+        {
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t)
+                pool.emplace_back([&, t] {
+                    EngineLease own(engine);
+                    if (own.get())
+                        solveRange(*own.get(), opts, in, out, status, n, next, workers[t]);
+                });
+            solveRange(*lease.get(), opts, in, out, status, n, next, workers[0]);   // caller thread works too
+            for (std::thread& th : pool)
+                th.join();
+        }
+
+        sudoku_stats batch{};
+        batch.puzzles = n;
+        batch.threads = threads;
+        SearchStats search;
+        for (const WorkerStats& ws : workers)
+        {
+            batch.already_solved += ws.counts[SUDOKU_STATUS_ALREADY_SOLVED];
+            batch.solved_logical += ws.counts[SUDOKU_STATUS_SOLVED_LOGICAL];
+            batch.solved_search += ws.counts[SUDOKU_STATUS_SOLVED_SEARCH];
+            batch.unsolvable += ws.counts[SUDOKU_STATUS_UNSOLVABLE];
+            batch.invalid += ws.counts[SUDOKU_STATUS_INVALID];
+            batch.budget_exceeded += ws.counts[SUDOKU_STATUS_BUDGET_EXCEEDED];
+            search.merge(ws.search);
+        }
+        batch.nodes = search.nodes;
+        batch.guesses = search.guesses;
+        batch.backtracks = search.backtracks;
+        batch.max_depth = search.maxDepth;
+        batch.elapsed_ns = (uint64_t)std::chrono::duration_cast<
+            std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+        {
+            std::lock_guard<std::mutex> guard(totalsLock);
+            addStats(totals, batch);
+        }
+        if (stats)
+            writeStats(stats, batch, statsSize);
+        return SUDOKU_OK;
+    }
+    catch (...) {
+        // nothing may unwind through the C boundary
+        return SUDOKU_ERROR_INTERNAL;
+    }
+}
+
+void sudoku_get_stats(sudoku_stats* stats)
+{
+    if (!stats)
+        return;
+    std::lock_guard<std::mutex> guard(totalsLock);
+    writeStats(stats, totals, STATS_V1_SIZE);
+}
+
+void sudoku_get_stats_sized(sudoku_stats* stats, size_t size)
+{
+    if (!stats)
+        return;
+    std::lock_guard<std::mutex> guard(totalsLock);
+    writeStats(stats, totals, size);
+}
+
+void sudoku_reset_stats(void)
+{
+    std::lock_guard<std::mutex> guard(totalsLock);
+    totals = sudoku_stats{};
+}
+
+const char* sudoku_engine_name(size_t index)
+{
+    const std::vector<std::string>& names = engineNames();
+    return index < names.size() ? names[index].c_str() : nullptr;
+}
+
+const char* sudoku_status_name(int status)
+{
+    switch (status)
+    {
+    case SUDOKU_STATUS_ALREADY_SOLVED: return "AlreadySolved";
+    case SUDOKU_STATUS_SOLVED_LOGICAL: return "SolvedByLogical";
+    case SUDOKU_STATUS_SOLVED_SEARCH: return "SolvedByBacktracking";
+    case SUDOKU_STATUS_UNSOLVABLE: return "Unsolvable";
+    case SUDOKU_STATUS_INVALID: return "Invalid";
+    case SUDOKU_STATUS_BUDGET_EXCEEDED: return "BudgetExceeded";
+    default: return "Unknown";
+    }
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+/*
+   C ABI of the solver (SudokuLib shared library).
+
+   Puzzles are passed as contiguous caller-owned buffers of 81 bytes per
+   puzzle, row-major, values 0..9 (0 = empty). Nothing is copied besides
+   the 81 bytes each worker solves in place, and out may alias in.
+
+   All functions are thread-safe. Every worker thread solves with its own
+   engine instance; instances are created on first use and pooled for
+   later calls.
+*/
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(SUDOKU_API_EXPORTS)
+#    define SUDOKU_API __declspec(dllexport)
+#  elif defined(SUDOKU_API_IMPORTS)
+#    define SUDOKU_API __declspec(dllimport)
+#  else
+#    define SUDOKU_API
+#  endif
+#else
+#  define SUDOKU_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+   Version 2 added the budget fields of sudoku_options, stats_size and
+   sudoku_stats::budget_exceeded. Structs only grow at the end; the library
+   reads and writes no more than the caller's size says, so binaries built
+   against an older header keep working.
+*/
+#define SUDOKU_API_VERSION 2
+#define SUDOKU_CELLS 81
+
+/* per-puzzle status, written to status[i] */
+enum
+{
+    SUDOKU_STATUS_ALREADY_SOLVED = 0,
+    SUDOKU_STATUS_SOLVED_LOGICAL = 1,
+    SUDOKU_STATUS_SOLVED_SEARCH = 2,
+    SUDOKU_STATUS_UNSOLVABLE = 3,
+    SUDOKU_STATUS_INVALID = 4,     /* value > 9 or conflicting givens */
+    SUDOKU_STATUS_BUDGET_EXCEEDED = 5  /* out is the input, possibly with logical placements */
+};
+
+/* return codes */
+enum
+{
+    SUDOKU_OK = 0,
+    SUDOKU_ERROR_ARGUMENT = -1,    /* null buffer or bad options */
+    SUDOKU_ERROR_ENGINE = -2,      /* unknown engine name */
+    SUDOKU_ERROR_INTERNAL = -3
+};
+
+typedef struct sudoku_options
+{
+    uint32_t size;                 /* sizeof(sudoku_options), for later extension */
+    uint32_t threads;              /* 0 = all hardware threads */
+    const char* engine;            /* NULL = "logical-simd"; see sudoku_engine_name,
+                                      "cached-"/"stored-" prefixes as in SolverRegistry */
+    /* version 2 */
+    uint64_t max_nodes;            /* per-puzzle search node budget, 0 = unlimited */
+    uint64_t time_limit_us;        /* per-puzzle time budget, 0 = unlimited */
+    uint32_t stats_size;           /* sizeof(sudoku_stats) of the caller; 0 = version 1 layout */
+} sudoku_options;
+
+typedef struct sudoku_stats
+{
+    uint64_t puzzles;
+    uint64_t already_solved;
+    uint64_t solved_logical;
+    uint64_t solved_search;
+    uint64_t unsolvable;
+    uint64_t invalid;
+    uint64_t nodes;                /* search counters, see SearchStats */
+    uint64_t guesses;
+    uint64_t backtracks;
+    uint32_t max_depth;
+    uint32_t threads;              /* threads actually used */
+    uint64_t elapsed_ns;
+    /* version 2: written only when the caller declares the size, see
+       sudoku_options.stats_size and sudoku_get_stats_sized */
+    uint64_t budget_exceeded;
+} sudoku_stats;
+
+SUDOKU_API int sudoku_api_version(void);
+
+/* fills defaults (size and stats_size included); callers that fill the
+   struct themselves must set size */
+SUDOKU_API void sudoku_default_options(sudoku_options* options);
+
+/*
+   Solves n puzzles from in (n * 81 bytes) into out (n * 81 bytes).
+   status (n bytes) and stats may be NULL. options may be NULL for defaults;
+   stats then gets the version 1 fields only.
+   Returns SUDOKU_OK or a negative error code; per-puzzle failures are
+   reported through status only.
+*/
+SUDOKU_API int sudoku_solve_batch(const uint8_t* in, uint8_t* out, uint8_t* status,
+    size_t n, const sudoku_options* options, sudoku_stats* stats);
+
+/* accumulated stats of every batch since load (or the last reset);
+   sudoku_get_stats writes the version 1 fields, the sized variant
+   min(size, sizeof(sudoku_stats)) bytes */
+SUDOKU_API void sudoku_get_stats(sudoku_stats* stats);
+SUDOKU_API void sudoku_get_stats_sized(sudoku_stats* stats, size_t size);
+SUDOKU_API void sudoku_reset_stats(void);
+
+/* engine names accepted by sudoku_options.engine; NULL past the end */
+SUDOKU_API const char* sudoku_engine_name(size_t index);
+SUDOKU_API const char* sudoku_status_name(int status);
+
+#ifdef __cplusplus
+}
+#endif
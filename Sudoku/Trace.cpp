@@ -0,0 +1,197 @@
+#include "Trace.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+    const char* name;
+    const char* category;
+    uint64_t startNs;
+    uint64_t durationNs;
+    int64_t arg;
+};
+
+struct Buffer
+{
+    uint32_t tid = 0;
+    std::string name;
+    std::unique_ptr<Event[]> ring{ new Event[Trace::RING_CAPACITY] };
+    uint64_t written = 0;   // total spans; ring holds the last RING_CAPACITY
+};
+
+std::mutex registryLock;
+std::vector<std::unique_ptr<Buffer>> registry;
+std::vector<Buffer*> freeBuffers;   // of threads that have exited
+std::string outputPath;
+Clock::time_point epoch = Clock::now();
+std::atomic<uint64_t> slowNs{ 1000000 };
+
+std::string defaultName(uint32_t tid)
+{
+    return tid == 1 ? "main" : "thread " + std::to_string(tid);
+}
+
+// Hands the buffer back when its thread exits. ParallelSolver and
+// StagedSolver start new threads on every call; reusing the buffers keeps
+// memory bounded by the peak thread count and gives one timeline track per
+// concurrent worker instead of one per OS thread.
+struct BufferLease
+{
+    Buffer* buffer = nullptr;
+
+    ~BufferLease()
+    {
+        if (!buffer)
+            return;
+        std::lock_guard<std::mutex> guard(registryLock);
+        freeBuffers.push_back(buffer);
+    }
+};
+
+thread_local BufferLease current;
+
+// takes a free buffer or allocates one, on the first span of a thread
+Buffer& threadBuffer()
+{
+    if (!current.buffer)
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        if (!freeBuffers.empty())
+        {
+            current.buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+        else
+        {
+            registry.push_back(std::make_unique<Buffer>());
+            current.buffer = registry.back().get();
+            current.buffer->tid = (uint32_t)registry.size();
+        }
+        current.buffer->name = defaultName(current.buffer->tid);
+    }
+    return *current.buffer;
+}
+
+void writeAtExit()
+{
+    if (!Trace::write())
+        std::cerr << "[TRACE] Cannot write " << outputPath << "\n";
+}
+
+void writeJsonString(std::ostream& out, const std::string& s)
+{
+    out << '"';
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if ((unsigned char)c < 0x20) out << ' ';
+        else out << c;
+    }
+    out << '"';
+}
+
+}
+
+void Trace::start(const std::string& path)
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    if (outputPath.empty())
+        std::atexit(writeAtExit);
+    outputPath = path;
+    epoch = Clock::now();
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Trace::startFromEnvironment()
+{
+    const char* path = std::getenv("SUDOKU_TRACE");
+    if (path && *path)
+        start(path);
+}
+
+uint64_t Trace::slowPuzzleNs()
+{
+    return slowNs.load(std::memory_order_relaxed);
+}
+
+void Trace::setSlowPuzzleNs(uint64_t ns)
+{
+    slowNs.store(ns, std::memory_order_relaxed);
+}
+
+uint64_t Trace::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+void Trace::nameThread(const char* name)
+{
+    if (enabled())
+        threadBuffer().name = name;
+}
+
+void Trace::record(const char* name, const char* category, uint64_t startNs, uint64_t endNs, int64_t arg)
+{
+    Buffer& b = threadBuffer();
+    b.ring[b.written % RING_CAPACITY] = { name, category, startNs, endNs - startNs, arg };
+    ++b.written;
+}
+
+bool Trace::write()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    if (outputPath.empty())
+        return true;
+
+    std::ofstream out(outputPath);
+    if (!out)
+        return false;
+
+    // ts / dur in microseconds with ns resolution
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    uint64_t spans = 0, dropped = 0;
+    for (const std::unique_ptr<Buffer>& b : registry)
+    {
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"name\":";
+        writeJsonString(out, b->name);
+        out << "}}";
+        first = false;
+
+        uint64_t n = b->written < RING_CAPACITY ? b->written : RING_CAPACITY;
+        dropped += b->written - n;
+        for (uint64_t k = b->written - n; k < b->written; ++k)
+        {
+            const Event& e = b->ring[k % RING_CAPACITY];
+            out << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid
+                << ",\"ts\":" << (double)e.startNs / 1000.0
+                << ",\"dur\":" << (double)e.durationNs / 1000.0;
+            if (e.arg >= 0)
+                out << ",\"args\":{\"v\":" << e.arg << "}";
+            out << "}";
+            ++spans;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cerr << "[TRACE] " << spans << " spans on " << registry.size() << " tracks written to "
+        << outputPath;
+    if (dropped)
+        std::cerr << " (" << dropped << " older spans overwritten)";
+    std::cerr << "\n";
+    return (bool)out;
+}
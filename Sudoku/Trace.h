@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Timeline tracing in Chrome trace format (chrome://tracing, Perfetto UI).
+// Each thread records complete spans into its own fixed-size ring buffer
+// (oldest spans are overwritten), so recording takes no lock and does not
+// allocate. Buffers outlive their threads: an exited thread's buffer (and
+// its track in the timeline) is reused by the next new thread. Everything is
+// written once, at exit or by Trace::write, after the workers have been
+// joined.
+//
+// Enabled at runtime with SUDOKU_TRACE=<file> in the environment or
+// --trace <file> on a command. When disabled a span costs one relaxed load.
+// Build with SUDOKU_TRACE=0 to compile the TRACE_* macros away completely.
+#ifndef SUDOKU_TRACE
+#define SUDOKU_TRACE 1
+#endif
+
+class Trace
+{
+public:
+    // spans per thread kept in the ring
+    static constexpr size_t RING_CAPACITY = 1 << 16;
+
+    // starts recording; the file is written at exit
+    static void start(const std::string& path);
+    // from SUDOKU_TRACE, no-op when unset
+    static void startFromEnvironment();
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    // writes every buffer now (also called at exit); false on I/O error
+    static bool write();
+
+    // names the calling thread in the timeline
+    static void nameThread(const char* name);
+
+    // puzzles slower than this get their own span (default 1 ms)
+    static uint64_t slowPuzzleNs();
+    static void setSlowPuzzleNs(uint64_t ns);
+
+    // ns since start(), monotonic
+    static uint64_t now();
+
+    // name and category must be string literals (stored by pointer)
+    static void record(const char* name, const char* category,
+        uint64_t startNs, uint64_t endNs, int64_t arg = -1);
+
+private:
+    static inline std::atomic<bool> active{ false };
+};
+
+// Span from construction to destruction; arg shows up as args.v.
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, int64_t arg = -1)
+        : name(name), category(category), arg(arg), start(Trace::enabled() ? Trace::now() : UINT64_MAX) {}
+
+    ~TraceScope()
+    {
+        if (start != UINT64_MAX)
+            Trace::record(name, category, start, Trace::now(), arg);
+    }
+
+    void setArg(int64_t v) { arg = v; }
+
+private:
+    const char* name;
+    const char* category;
+    int64_t arg;
+    uint64_t start;
+};
+
+#if SUDOKU_TRACE
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SCOPE(name, category, arg) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, category, arg)
+#define TRACE_ENABLED() Trace::enabled()
+#else
+#define TRACE_SCOPE(name, category, arg) ((void)0)
+#define TRACE_ENABLED() false
+#endif
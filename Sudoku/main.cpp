@@ -9,7 +9,19 @@
 #include "LogicalSolver.h"
 #include "LogicalSolverSIMD.h"
 #include "ParallelSolver.h"
+#include "LatencyHistogram.h"
 #include "CUDASolver.h"
+#include "CommandLine.h"
+#include "Benchmark.h"
+#include "RouterSolver.h"
+#include "SolutionStore.h"
+#include "PuzzleGenerator.h"
+#include "SolveServer.h"
+#include "RegressionSuite.h"
+#include "StagedSolver.h"
+#include "AllocStats.h"
+#include "ShardRunner.h"
+#include "Trace.h"
 
 extern "C" void runCudaSanity();
 
@@ -23,6 +35,10 @@ static const bool RUN_PARALLEL = false;
 static const bool RUN_COMPARE = true;
 static const size_t MAX_SUDOKU_PER_DATASET = 250;
 static const int  THREAD_COUNT = 20;
+static const bool ASSUME_UNIQUE = false; // enables UR / BUG+1 (only for unique puzzles)
+static const bool MEASURE_LATENCY = false; // per-puzzle timing + percentiles
+static const size_t SLOWEST_PUZZLES = 10;
+static const bool MEASURE_ALLOCS = false; // heap allocations per phase (needs SUDOKU_COUNT_ALLOCS=1)
 
 /* ============================================================
    STATS PRINT
@@ -56,6 +72,18 @@ static void printStats(
     if (stats.unsolvable)
         std::cout << "Unsolvable             : "
         << stats.unsolvable << "\n";
+
+    if (stats.budgetExceeded)
+        std::cout << "Budget exceeded        : "
+        << stats.budgetExceeded << "\n";
+
+    if (stats.search.nodes)
+        std::cout << "Search                 : nodes=" << stats.search.nodes
+        << " guesses=" << stats.search.guesses
+        << " backtracks=" << stats.search.backtracks
+        << " maxDepth=" << stats.search.maxDepth
+        << (stats.search.restarts ? " restarts=" + std::to_string(stats.search.restarts) : std::string())
+        << "\n";
 }
 
 /* ============================================================
@@ -64,27 +92,41 @@ static void printStats(
 static void runSolver(
     ISudokuSolver& solver,
     const std::vector<std::vector<Sudoku>>& baseDatasets,
+    std::vector<std::vector<Sudoku>>& datasets,
     bool parallel,
     int threadCount,
     std::vector<std::vector<Sudoku>>* outCopy)
 {
-    // solver-local deep copy (AYNEN KALIR)
-    std::vector<std::vector<Sudoku>> datasets = baseDatasets;
+    // solver-local deep copy (AYNEN KALIR) into the caller's buffer; it keeps
+    // its capacity between runs, so only the first copy allocates
+    AllocPhase copyPhase("copy");
+    datasets = baseDatasets;
+    if (MEASURE_ALLOCS)
+        copyPhase.print(std::cout);
+
+    AllocPhase solvePhase("solve");
 
+    TRACE_SCOPE("runSolver", "run", parallel ? threadCount : 1);
     SolveStats totalStats;
     Clock::time_point t0 = Clock::now();
 
     for (size_t d = 0; d < datasets.size(); ++d)
     {
+        TRACE_SCOPE("dataset", "run", (int64_t)d);
         std::vector<Sudoku>& dataset = datasets[d];
         size_t clues = dataset.front().GetAssignedCellCount();
         size_t sudokuCount = dataset.size();
 
+        LatencyReport latency(SLOWEST_PUZZLES);
+
         Clock::time_point s = Clock::now();
         SolveStats ds;
 
         if (parallel)
-            ds = ParallelSolver::solveAll(solver, dataset, threadCount);
+            ds = ParallelSolver::solveAll(solver, dataset, threadCount,
+                MEASURE_LATENCY ? &latency : nullptr);
+        else if (MEASURE_LATENCY)
+            ds = LatencyReport::solveAll(solver, dataset, latency);
         else
             ds = solver.solveAll(dataset);
 
@@ -96,20 +138,28 @@ static void runSolver(
         double msPerSudoku =
             sudokuCount ? (double)elapsedMs / (double)sudokuCount : 0.0;
 
-        totalStats.alreadySolved += ds.alreadySolved;
-        totalStats.logical += ds.logical;
-        totalStats.backtracking += ds.backtracking;
-        totalStats.unsolvable += ds.unsolvable;
+        totalStats.merge(ds);
 
         std::cout
             << "[Dataset" << d << " ("
             << sudokuCount << " sudokus with "
             << clues << "/81 initial clues)] finished in "
             << elapsedMs << " ms "
-            << "[" << msPerSudoku << " ms/sudoku]\n";
+            << "[" << msPerSudoku << " ms/sudoku]";
+        if (ds.search.nodes)
+            std::cout << " [search nodes=" << ds.search.nodes
+                << " guesses=" << ds.search.guesses
+                << " backtracks=" << ds.search.backtracks
+                << " maxDepth=" << ds.search.maxDepth << "]";
+        std::cout << "\n";
+
+        if (MEASURE_LATENCY)
+            latency.print(std::cout, ("Dataset" + std::to_string(d)).c_str());
     }
 
     Clock::time_point t1 = Clock::now();
+    if (MEASURE_ALLOCS)
+        solvePhase.print(std::cout);
     printStats(
         (std::string(solver.getName()) +
             (parallel ? " Parallel" : " Sequential")).c_str(),
@@ -142,18 +192,102 @@ static void runSolver(
 			<< " effect=" << st.data[6][1] << "\n";
 		std::cout << "HiddenTriple       : hit=" << st.data[7][0]
 			<< " effect=" << st.data[7][1] << "\n";
+        std::cout << "NakedQuad          : hit=" << st.data[LS_NAKED_QUAD][0]
+            << " effect=" << st.data[LS_NAKED_QUAD][1] << "\n";
+        std::cout << "HiddenQuad         : hit=" << st.data[LS_HIDDEN_QUAD][0]
+            << " effect=" << st.data[LS_HIDDEN_QUAD][1] << "\n";
+        std::cout << "TrialPropagation   : hit=" << st.data[LS_TRIAL_PROPAGATION][0]
+            << " effect=" << st.data[LS_TRIAL_PROPAGATION][1] << "\n";
+        if (ls->getOptions().assumeUnique)
+        {
+            std::cout << "UniqueRectangle    : hit=" << st.data[LS_UNIQUE_RECTANGLE][0]
+                << " effect=" << st.data[LS_UNIQUE_RECTANGLE][1] << "\n";
+            std::cout << "BugPlusOne         : hit=" << st.data[LS_BUG_PLUS_ONE][0]
+                << " effect=" << st.data[LS_BUG_PLUS_ONE][1] << "\n";
+        }
+
+        // build with LOGICAL_PROFILE=1 to collect these
+        if (LOGICAL_PROFILE)
+        {
+            const LogicalProfile& pf = ls->getLogicalProfile();
+            uint64_t allCycles = 0;
+            for (int t = 0; t < LS_COUNT; ++t)
+                allCycles += pf.cycles[t];
+
+            std::cout << "\n[Logical Cost]\n";
+            for (int t = 0; t < LS_COUNT; ++t)
+            {
+                if (!pf.calls[t]) continue;
+                std::string name = LogicalSolver::techniqueName(t);
+                name.resize(19, ' ');
+                std::cout << name << ": calls=" << pf.calls[t]
+                    << " Mcycles=" << pf.cycles[t] / 1000000
+                    << " (" << (allCycles ? 100.0 * pf.cycles[t] / allCycles : 0.0) << "%)"
+                    << " cycles/call=" << pf.cycles[t] / pf.calls[t]
+                    << " wasted=" << pf.wastedCalls[t]
+                    << " (" << 100.0 * pf.wastedCycles[t] / (pf.cycles[t] ? pf.cycles[t] : 1)
+                    << "% of cycles)\n";
+            }
+        }
     }
 }
 
 /* ============================================================
    MAIN
    ============================================================ */
-int main()
+int main(int argc, char** argv)
 {
+    // SUDOKU_TRACE=<file> or --trace <file>: Chrome trace JSON at exit
+    Trace::startFromEnvironment();
+
+    // command modes: Sudoku <command> [options]
+    if (argc > 1)
+    {
+        std::string command = argv[1];
+        CommandLine cmd(argc - 1, argv + 1);
+        if (cmd.has("trace"))
+            Trace::start(cmd.get("trace"));
+        try
+        {
+            if (command == "bench")
+                return Benchmark::runCommand(cmd);
+            if (command == "calibrate-router")
+                return RouterSolver::calibrateCommand(cmd);
+            if (command == "store")
+                return SolutionStore::runCommand(cmd);
+            if (command == "generate")
+                return PuzzleGenerator::runCommand(cmd);
+            if (command == "serve")
+                return SolveServer::runCommand(cmd);
+            if (command == "regress")
+                return RegressionSuite::runCommand(cmd);
+            if (command == "stages")
+                return StagedSolver::runCommand(cmd);
+            if (command == "alloc-check")
+                return AllocCheck::runCommand(cmd);
+            if (command == "shard")
+                return ShardRunner::runCommand(cmd);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[ERROR] " << e.what() << "\n";
+            return 1;
+        }
+
+        std::cerr << "Unknown command: " << command << "\n"
+            << "Commands: bench, calibrate-router, store, generate, serve, regress, stages, alloc-check, shard\n"
+            << "Run without arguments for the default comparison run.\n"
+            << "Any command: --trace FILE writes a Chrome trace (or set SUDOKU_TRACE=FILE).\n";
+        return 2;
+    }
+
 	runCudaSanity();
 
+    AllocPhase loadPhase("load");
     std::vector<std::vector<Sudoku>> baseDatasets =
         DatasetLoader::loadAllDatasets("Dataset");
+    if (MEASURE_ALLOCS)
+        loadPhase.print(std::cout);
 
     std::vector<std::vector<Sudoku>> copy = baseDatasets;
 
@@ -173,11 +307,12 @@ int main()
 
     std::vector<std::vector<Sudoku>> groundTruth;
     std::vector<std::vector<Sudoku>> toTest;
+    std::vector<std::vector<Sudoku>> work;   // runSolver's copy, reused across runs
 
     std::vector<ISudokuSolver*> solvers;
     //solvers.push_back(new BacktrackingSolver());
     //solvers.push_back(new BacktrackingSolverMRV());
-    solvers.push_back(new LogicalSolver());
+    solvers.push_back(new LogicalSolver(LogicalOptions{ ASSUME_UNIQUE }));
     //solvers.push_back(new LogicalSolverSIMD());
 
     for (size_t i = 0; i < solvers.size(); ++i)
@@ -192,6 +327,7 @@ int main()
             runSolver(
                 solver,
                 baseDatasets,
+                work,
                 false,
                 THREAD_COUNT,
                 (RUN_COMPARE && i == 0) ? &groundTruth :
@@ -205,6 +341,7 @@ int main()
             runSolver(
                 solver,
                 baseDatasets,
+                work,
                 true,
                 THREAD_COUNT,
                 nullptr
@@ -215,6 +352,7 @@ int main()
 	toTest = copy; // CUDA sonularn karlatrmak iin
     if (RUN_COMPARE && !groundTruth.empty() && !toTest.empty())
     {
+        AllocPhase comparePhase("compare");
         bool allSame = true;
 
         for (size_t d = 0; d < groundTruth.size(); ++d)
@@ -235,6 +373,8 @@ int main()
         if (allSame)
             std::cout
             << "\n[COMPARE] All sequential solvers produced identical results.\n";
+        if (MEASURE_ALLOCS)
+            comparePhase.print(std::cout);
     }
 
     for (size_t i = 0; i < solvers.size(); ++i)
@@ -91,7 +91,7 @@ static inline __m256i mask_single_bit_epi16(__m256i m)
 
     NOTE:
     This is more expensive than single-bit detection.
-    Useful for Naked Pair logic (future use).
+    Used by LogicalSolverSIMD naked pair detection.
 */
 static inline __m256i mask_two_bits_epi16(__m256i m)
 {
@@ -166,15 +166,92 @@ static inline void store_u16(uint16_t* ptr, __m256i v)
     _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v);
 }
 
+// ============================================================
+// Lane-wise counting / lane mask helpers
+// ============================================================
+
+/*
+    Lane-wise popcount of 16-bit lanes.
+    Nibble lookup with pshufb, then bytes of each lane are added.
+*/
+static inline __m256i popcount_epi16(__m256i v)
+{
+    const __m256i lut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low4));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+    __m256i bytes = _mm256_add_epi8(lo, hi);
+
+    // low byte + high byte of each lane
+    return _mm256_and_si256(
+        _mm256_add_epi16(bytes, _mm256_srli_epi16(bytes, 8)),
+        vone16(0x00FF));
+}
+
+/*
+    Sum of all set bits in the vector (all lanes).
+*/
+static inline uint32_t popcount_sum_epi16(__m256i v)
+{
+    __m256i counts = popcount_epi16(v);
+
+    // lanes are <= 16, so byte-wise SAD against zero gives 4 x 64-bit sums
+    __m256i sums = _mm256_sad_epu8(counts, vzero());
+    return (uint32_t)(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                      _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+}
+
+/*
+    Compact lane mask: bit i == 1 -> lane i is true.
+    (movemask_epi16 returns two bits per lane.)
+*/
+static inline uint32_t lane_bits_epi16(__m256i mask)
+{
+    // saturating pack keeps 0x0000 / 0xFFFF as 0x00 / 0xFF,
+    // permute puts lanes 0..7 and 8..15 next to each other
+    __m256i packed = _mm256_packs_epi16(mask, vzero());
+    packed = _mm256_permute4x64_epi64(packed, 0b11011000);
+    return (uint32_t)_mm256_movemask_epi8(packed) & 0xFFFF;
+}
+
+/*
+    Inverse of lane_bits_epi16: lane i = 0xFFFF when bit i is set.
+*/
+static inline __m256i expand_lane_bits_epi16(uint32_t bits)
+{
+    const __m256i laneBit = _mm256_setr_epi16(
+        0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+        0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, (int16_t)0x8000);
+
+    __m256i sel = _mm256_and_si256(vone16((uint16_t)bits), laneBit);
+    return _mm256_cmpeq_epi16(sel, laneBit);
+}
+
+// ============================================================
+// Unit reductions
+// ============================================================
+
+/*
+    OR of three unit vectors.
+    With row vectors (lane = column) this gives, per column, the
+    candidates of one box-column segment; with column vectors it
+    gives box-row segments.
+*/
+static inline __m256i or3_epi16(__m256i a, __m256i b, __m256i c)
+{
+    return _mm256_or_si256(_mm256_or_si256(a, b), c);
+}
+
 // ============================================================
 // Notes for future extensions
 // ============================================================
 
 /*
     Possible future additions:
-    - lane-wise popcount approximations
     - digit-wise accumulation (hidden single)
-    - unit-based reductions (row/col/box)
     - AVX-512 variants (mask registers)
 
     This header intentionally keeps SIMD primitives isolated